@@ -6,6 +6,14 @@ uniform uint tile_id;
 uniform uint tile_count_x;
 uniform uint tile_count_y;
 
+// Palettized textures store 8-bit indices (in red) into palette_texture
+uniform bool is_palettized;
+uniform sampler2D palette_texture;
+
+// Texels of this color are transparent (when has_color_key is set)
+uniform bool has_color_key;
+uniform vec3 color_key;
+
 // UV with quad (<0,1>x<0,1> for the whole quad)
 in vec2 uv; 
 
@@ -32,4 +40,13 @@ void main()
     texture_uv.y = tex_size.y - texture_uv.y-1;
 
     FragColor = texelFetch(tile_texture, texture_uv,0);
+    if (is_palettized)
+    {
+        int index = int(FragColor.r * 255.0 + 0.5);
+        FragColor = texelFetch(palette_texture, ivec2(index, 0), 0);
+    }
+    if (has_color_key && all(lessThan(abs(FragColor.rgb - color_key), vec3(0.5 / 255.0))))
+    {
+        FragColor.a = 0.0;
+    }
 } 
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <bm/animation.hpp>
+#include <bm/event_distributor.hpp>
+#include <bm/tileset_registry.hpp>
+#include <bm/world.hpp>
+
+namespace {
+const std::vector<std::string> tileset_names{
+  "characters/bomberman.json", "characters/npc.json", "bomb.json",
+  "fire.json",                 "pickups.json",        "crate.json",
+};
+
+/// @brief Tileset with 4 animations of 4 keypoints (and no texture)
+auto
+make_animated_tileset() -> std::shared_ptr<render::Tileset>
+{
+  auto tileset = std::make_shared<render::Tileset>();
+  tileset->animations.resize(4);
+  for (auto& animation : tileset->animations) {
+    for (unsigned tile = 0; tile < 4; tile++) {
+      animation.sequence.push_back(
+        { std::chrono::milliseconds{ 16 + tile * 16 }, tile });
+    }
+  }
+  tileset->texture_ = std::make_shared<const render::Texture>();
+  return tileset;
+}
+
+/// @brief World of `count` animated entities, spread over all tilesets
+auto
+populate(bm::World& world, unsigned count) -> void
+{
+  for (unsigned i = 0; i < count; i++) {
+    world.create(bm::Entity::Type::particle)
+      .set_tileset(tileset_names[i % tileset_names.size()])
+      .set_animation(i % 4);
+  }
+}
+} // namespace
+
+/// @brief Per-frame tileset work of `Game::on_render` for animated entities:
+/// animations are advanced and each entity's tileset is acquired for drawing
+static void
+BM_AnimatedEntitiesFrame(benchmark::State& state)
+{
+  bm::EventDistributor event_distributor;
+  bm::World world{ event_distributor };
+  populate(world, static_cast<unsigned>(state.range(0)));
+
+  bm::TilesetRegistry registry;
+  registry.insert(bm::TilesetHandle{}, make_animated_tileset(), true);
+  for (const auto& name : tileset_names) {
+    registry.insert(bm::TilesetHandle{ name }, make_animated_tileset(), true);
+  }
+
+  for (auto _ : state) {
+    bm::update_animations(world, registry, std::chrono::milliseconds{ 16 });
+    for (auto& [id, entity] : world) {
+      benchmark::DoNotOptimize(registry.acquire(entity.tile_.tileset_));
+    }
+    registry.update();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AnimatedEntitiesFrame)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/// @brief Same frame, but tilesets are keyed by name (as before handles)
+static void
+BM_AnimatedEntitiesFrameByName(benchmark::State& state)
+{
+  bm::EventDistributor event_distributor;
+  bm::World world{ event_distributor };
+  populate(world, static_cast<unsigned>(state.range(0)));
+
+  std::unordered_map<std::string, std::shared_ptr<render::Tileset>> tilesets;
+  for (const auto& name : tileset_names) {
+    tilesets.emplace(name, make_animated_tileset());
+  }
+  // Tileset's name of each entity (in place of its handle), in the order of
+  // world's iteration
+  std::vector<std::string> names;
+  for (auto& [id, entity] : world) {
+    names.push_back(entity.tile_.tileset_.get_name());
+  }
+
+  for (auto _ : state) {
+    // Animation update & draw both look the tileset up
+    auto name = names.cbegin();
+    for (auto& [id, entity] : world) {
+      bm::advance_animation(entity,
+                            tilesets.find(*name++)->second.get(),
+                            std::chrono::milliseconds{ 16 });
+    }
+    name = names.cbegin();
+    for (auto& [id, entity] : world) {
+      benchmark::DoNotOptimize(tilesets.find(*name++)->second.get());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AnimatedEntitiesFrameByName)
+  ->Arg(10000)
+  ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include <bm/event_distributor.hpp>
+#include <bm/events.hpp>
+
+namespace {
+struct CountingListener
+{
+  auto handle(const bm::event::EntityCollide&) -> void { count_++; }
+  auto handle(const bm::event::DeleteEntity&) -> void { count_++; }
+
+  unsigned count_{ 0 };
+};
+} // namespace
+
+static void
+BM_EventDistributorEnqueue(benchmark::State& state)
+{
+  bm::EventDistributor event_distributor;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); i++) {
+      event_distributor.enqueue_event(bm::event::EntityCollide{
+        static_cast<bm::Entity::Id>(i), static_cast<bm::Entity::Id>(i + 1) });
+    }
+    state.PauseTiming();
+    event_distributor.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EventDistributorEnqueue)->RangeMultiplier(8)->Range(8, 4096);
+
+/// @brief Enqueue & dispatch of a frame's worth of events (2 types)
+static void
+BM_EventDistributorDispatch(benchmark::State& state)
+{
+  bm::EventDistributor event_distributor;
+  CountingListener listener;
+  event_distributor
+    .registry_listener<bm::event::EntityCollide, bm::event::DeleteEntity>(
+      listener);
+
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); i++) {
+      const auto id = static_cast<bm::Entity::Id>(i);
+      if (i % 2 == 0) {
+        event_distributor.enqueue_event(bm::event::EntityCollide{ id, id });
+      } else {
+        event_distributor.enqueue_event(bm::event::DeleteEntity{ { id } });
+      }
+    }
+    event_distributor.dispatch();
+  }
+  benchmark::DoNotOptimize(listener.count_);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EventDistributorDispatch)->RangeMultiplier(8)->Range(8, 4096);
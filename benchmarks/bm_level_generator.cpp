@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+#include <bm/interfaces/game.hpp>
+#include <bm/level.hpp>
+#include <bm/level_generator.hpp>
+#include <bm/navigation_mesh.hpp>
+#include <bm/simulation.hpp>
+#include <utils/allocation_tracker.hpp>
+
+namespace {
+/// @brief Game of a generated `side` x `side` level
+class GeneratedGame : public bm::interfaces::IGame
+{
+public:
+  GeneratedGame(unsigned side, float npc_density)
+    : level_{ bm::Level::Settings{} }
+  {
+    bm::LevelGenerator::Settings settings;
+    settings.width = side;
+    settings.height = side;
+    settings.npc_density = npc_density;
+    level_.map_ = bm::LevelGenerator::generate(settings);
+  }
+
+  auto get_current_level() const -> const bm::Level* override
+  {
+    return &level_;
+  }
+
+private:
+  bm::Level level_;
+};
+} // namespace
+
+/// @brief Parse of a generated `range(0)` sized map (base64 & zlib layers)
+static void
+BM_GeneratedLevelLoad(benchmark::State& state)
+{
+  const auto side = static_cast<unsigned>(state.range(0));
+  bm::LevelGenerator::Settings settings;
+  settings.width = side;
+  settings.height = side;
+  const auto file =
+    std::filesystem::temp_directory_path() / "b0mb3rman_bench.map.json";
+  bm::LevelGenerator::write_map(
+    *bm::LevelGenerator::generate(settings), file, "tiles.json", { 8, 8 });
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(render::TiledMap::load_map(file, nullptr));
+  }
+  state.SetComplexityN(side * side);
+  state.SetBytesProcessed(state.iterations() *
+                          std::filesystem::file_size(file));
+  std::filesystem::remove(file);
+}
+BENCHMARK(BM_GeneratedLevelLoad)
+  ->RangeMultiplier(4)
+  ->Range(64, 4096)
+  ->Unit(benchmark::kMillisecond)
+  ->Complexity();
+
+/// @brief Rebuild of the navigation graph of a generated `range(0)` level
+static void
+BM_GeneratedNavigationMeshUpdate(benchmark::State& state)
+{
+  const auto side = static_cast<unsigned>(state.range(0));
+  GeneratedGame game{ side, 0.0f };
+  bm::GameController::Texts texts;
+  bm::Simulation simulation{ game, texts, bm::Simulation::Settings{ true } };
+  simulation.load_static_collisions(*game.get_current_level()->map_);
+  bm::NavigationMesh navigation_mesh{ simulation.world_ };
+
+  for (auto _ : state) {
+    navigation_mesh.update();
+  }
+  state.SetComplexityN(side * side);
+}
+BENCHMARK(BM_GeneratedNavigationMeshUpdate)
+  ->RangeMultiplier(4)
+  ->Range(64, 4096)
+  ->Unit(benchmark::kMillisecond)
+  ->Complexity();
+
+/**
+ * @brief Simulation tick of a generated `range(0)` level
+ *
+ * `range(1)` is NPC density in per mille (of free cells without crates).
+ * Ticks follow a warm-up, so that NPCs have planned their paths. With
+ * allocation tracking, allocations per tick are reported as well.
+ */
+static void
+BM_GeneratedLevelTick(benchmark::State& state)
+{
+  const auto side = static_cast<unsigned>(state.range(0));
+  GeneratedGame game{ side, state.range(1) / 1000.0f };
+  bm::GameController::Texts texts;
+  bm::Simulation simulation{ game, texts, bm::Simulation::Settings{ true } };
+  simulation.load_static_collisions(*game.get_current_level()->map_);
+  simulation.start();
+  for (unsigned i = 0; i < 10; i++) {
+    simulation.tick();
+  }
+
+  const auto begin = utils::AllocationTracker::get_thread_counters();
+  for (auto _ : state) {
+    simulation.tick();
+  }
+  state.counters["entities"] = static_cast<double>(simulation.world_.size());
+  if (utils::AllocationTracker::is_enabled) {
+    const auto allocations =
+      utils::AllocationTracker::get_thread_counters() - begin;
+    state.counters["allocations"] =
+      benchmark::Counter(static_cast<double>(allocations.allocations_),
+                         benchmark::Counter::kAvgIterations);
+  }
+}
+BENCHMARK(BM_GeneratedLevelTick)
+  ->ArgsProduct({ { 32, 64, 128 }, { 0, 10 } })
+  ->ArgNames({ "side", "npc_permille" })
+  ->Unit(benchmark::kMillisecond);
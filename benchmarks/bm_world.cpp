@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <bm/event_distributor.hpp>
+#include <bm/navigation_mesh.hpp>
+#include <bm/world.hpp>
+
+namespace {
+/// @brief Exposes collision detection, which is otherwise run by `update()`
+class BenchmarkWorld : public bm::World
+{
+public:
+  using bm::World::detect_collisions;
+  using bm::World::World;
+};
+
+/// @brief `side` x `side` level, walled around, with bomberman-style pillars
+auto
+make_level(bm::World& world, unsigned side) -> void
+{
+  world.update_boundary(glm::vec2(0, 0), glm::vec2(side, side));
+  utils::OccupancyMap2D<bool> collisions{ { side, side }, false };
+  collisions.update([side](const auto index, bool) {
+    const auto is_border = index[0] == 0 or index[1] == 0 or
+                           index[0] == side - 1 or index[1] == side - 1;
+    return is_border or (index[0] % 2 == 0 and index[1] % 2 == 0);
+  });
+  world.update_static_collisions(std::move(collisions));
+}
+
+/// @brief `count` moving entities of mixed types on free cells
+auto
+populate(bm::World& world, unsigned side, unsigned count) -> void
+{
+  std::mt19937 generator{ 42 };
+  // Odd cells are free
+  std::uniform_int_distribution<unsigned> cell{ 0, side / 2 - 2 };
+  const bm::Entity::Type types[] = { bm::Entity::Type::npc,
+                                     bm::Entity::Type::fire,
+                                     bm::Entity::Type::pickup };
+  for (unsigned i = 0; i < count; i++) {
+    auto& entity =
+      world.create(types[i % 3])
+        .set_origin(glm::vec2(cell(generator) * 2 + 1, cell(generator) * 2 + 1))
+        .set_size(glm::vec2(0.8f, 0.8f))
+        .set_max_speed(4.0f);
+    entity.controller_.moving_right = i % 2 == 0;
+    entity.controller_.moving_down = i % 2 == 1;
+  }
+}
+} // namespace
+
+/// @brief World step with `range(0)` moving entities on a 64x64 level
+static void
+BM_WorldUpdate(benchmark::State& state)
+{
+  bm::EventDistributor event_distributor;
+  bm::World world{ event_distributor };
+  make_level(world, 64);
+  populate(world, 64, static_cast<unsigned>(state.range(0)));
+
+  for (auto _ : state) {
+    world.update(std::chrono::milliseconds{ 16 });
+    // Collision events would pile up otherwise
+    event_distributor.clear();
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_WorldUpdate)
+  ->RangeMultiplier(4)
+  ->Range(16, 1024)
+  ->Unit(benchmark::kMicrosecond)
+  ->Complexity();
+
+static void
+BM_WorldDetectCollisions(benchmark::State& state)
+{
+  bm::EventDistributor event_distributor;
+  BenchmarkWorld world{ event_distributor };
+  make_level(world, 64);
+  populate(world, 64, static_cast<unsigned>(state.range(0)));
+
+  for (auto _ : state) {
+    world.detect_collisions();
+    event_distributor.clear();
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_WorldDetectCollisions)
+  ->RangeMultiplier(4)
+  ->Range(16, 1024)
+  ->Unit(benchmark::kMicrosecond)
+  ->Complexity();
+
+/// @brief Rebuild of the navigation graph of a `range(0)` sized level
+static void
+BM_NavigationMeshUpdate(benchmark::State& state)
+{
+  const auto side = static_cast<unsigned>(state.range(0));
+  bm::EventDistributor event_distributor;
+  bm::World world{ event_distributor };
+  make_level(world, side);
+  bm::NavigationMesh navigation_mesh{ world };
+
+  for (auto _ : state) {
+    navigation_mesh.update();
+  }
+  state.SetComplexityN(side * side);
+}
+BENCHMARK(BM_NavigationMeshUpdate)
+  ->RangeMultiplier(2)
+  ->Range(8, 64)
+  ->Unit(benchmark::kMicrosecond)
+  ->Complexity();
+
+/// @brief Path between opposite corners of a `range(0)` sized level
+static void
+BM_NavigationMeshComputePath(benchmark::State& state)
+{
+  const auto side = static_cast<unsigned>(state.range(0));
+  bm::EventDistributor event_distributor;
+  bm::World world{ event_distributor };
+  make_level(world, side);
+  bm::NavigationMesh navigation_mesh{ world };
+  navigation_mesh.update();
+
+  const auto start = glm::vec2(1, 1);
+  const auto end = glm::vec2(side - 3, side - 3);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(navigation_mesh.compute_path(start, end));
+  }
+  state.SetComplexityN(side * side);
+}
+BENCHMARK(BM_NavigationMeshComputePath)
+  ->RangeMultiplier(2)
+  ->Range(8, 32)
+  ->Unit(benchmark::kMicrosecond)
+  ->Complexity();
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+#include <render/loader.hpp>
+
+namespace {
+auto
+get_character_images() -> std::vector<std::filesystem::path>
+{
+  std::vector<std::filesystem::path> result;
+  const auto directory =
+    std::filesystem::path{ B0MB3RMAN_ASSETS_DIRECTORY } / "characters";
+  for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+    if (entry.path().extension() == ".png") {
+      result.push_back(entry.path());
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+} // namespace
+
+/// @brief Decode all PNGs in assets/characters (CPU part of texture loading)
+static void
+BM_DecodeCharacters(benchmark::State& state)
+{
+  const auto images = get_character_images();
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    for (const auto& path : images) {
+      const auto image = render::load_image_from_file(path);
+      benchmark::DoNotOptimize(image.pixels_);
+      bytes += image.get_pixels_size();
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+  state.counters["images"] = static_cast<double>(images.size());
+}
+BENCHMARK(BM_DecodeCharacters)->Unit(benchmark::kMillisecond);
+
+/// @brief Palettize all character images (as the cook tool does)
+static void
+BM_PalettizeCharacters(benchmark::State& state)
+{
+  std::vector<render::ImageData> images;
+  for (const auto& path : get_character_images()) {
+    images.push_back(render::load_image_from_file(path));
+  }
+
+  std::size_t bytes = 0;
+  std::size_t palettized_bytes = 0;
+  for (auto _ : state) {
+    bytes = palettized_bytes = 0;
+    for (const auto& image : images) {
+      const auto palettized = render::palettize_image(image);
+      benchmark::DoNotOptimize(palettized);
+      bytes += image.get_pixels_size();
+      palettized_bytes +=
+        palettized ? palettized->get_pixels_size() : image.get_pixels_size();
+    }
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(bytes * state.iterations()));
+  // Ratio of texture memory left after palettization
+  state.counters["size_ratio"] = static_cast<double>(palettized_bytes) / bytes;
+}
+BENCHMARK(BM_PalettizeCharacters)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include <utils/aabb.hpp>
+#include <utils/occupancy_map.hpp>
+
+static void
+BM_OccupancyMapAt(benchmark::State& state)
+{
+  const auto side = static_cast<unsigned>(state.range(0));
+  const utils::OccupancyMap2D<bool> map{ { side, side }, false };
+  for (auto _ : state) {
+    for (unsigned y = 0; y < side; y++) {
+      for (unsigned x = 0; x < side; x++) {
+        benchmark::DoNotOptimize(map.at({ x, y }));
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * side * side);
+}
+BENCHMARK(BM_OccupancyMapAt)->RangeMultiplier(4)->Range(16, 1024);
+
+static void
+BM_OccupancyMapForEach(benchmark::State& state)
+{
+  const auto side = static_cast<unsigned>(state.range(0));
+  const utils::OccupancyMap2D<bool> map{ { side, side }, false };
+  for (auto _ : state) {
+    unsigned occupied = 0;
+    map.for_each([&occupied](const auto&, bool cell) { occupied += cell; });
+    benchmark::DoNotOptimize(occupied);
+  }
+  state.SetItemsProcessed(state.iterations() * side * side);
+}
+BENCHMARK(BM_OccupancyMapForEach)->RangeMultiplier(4)->Range(16, 1024);
+
+/// @brief All pairs of `count` boxes, scattered over a 64x64 area
+static void
+BM_AABBCollide(benchmark::State& state)
+{
+  std::mt19937 generator{ 42 };
+  std::uniform_real_distribution<float> position{ 0.0f, 64.0f };
+  std::vector<utils::AABB> boxes;
+  for (int i = 0; i < state.range(0); i++) {
+    boxes.push_back(utils::AABB{ glm::vec2(position(generator), position(generator)),
+                                 glm::vec2(1.0f, 1.0f) });
+  }
+
+  for (auto _ : state) {
+    unsigned collisions = 0;
+    for (const auto& a : boxes) {
+      for (const auto& b : boxes) {
+        collisions += a.collide(b);
+      }
+    }
+    benchmark::DoNotOptimize(collisions);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+BENCHMARK(BM_AABBCollide)->RangeMultiplier(4)->Range(16, 1024);
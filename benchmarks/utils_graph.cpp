@@ -0,0 +1,217 @@
+#include <benchmark/benchmark.h>
+
+#include <utils/graph.hpp>
+#include <utils/graph_algorithms.hpp>
+
+namespace {
+/// @brief `side` x `side` grid with 4-neighbourhood (as in NavigationMesh)
+auto
+make_grid(unsigned side) -> utils::UnorientedGraph<>
+{
+  utils::UnorientedGraph<> graph;
+  for (unsigned y = 0; y < side; y++) {
+    for (unsigned x = 0; x < side; x++) {
+      const auto id = x + y * side;
+      graph.add_vertex(id);
+      if (x + 1 < side) {
+        graph.add_edge(id, id + 1);
+      }
+      if (y + 1 < side) {
+        graph.add_edge(id, id + side);
+      }
+    }
+  }
+  return graph;
+}
+
+/// @brief Oriented path 0 -> 1 -> ... -> count-1
+auto
+make_chain(unsigned count) -> utils::OrientedGraph<>
+{
+  utils::OrientedGraph<> graph;
+  graph.add_vertex(0);
+  for (unsigned i = 1; i < count; i++) {
+    graph.add_edge(i - 1, i);
+  }
+  return graph;
+}
+
+auto
+get_side(const benchmark::State& state) -> unsigned
+{
+  return static_cast<unsigned>(state.range(0));
+}
+} // namespace
+
+/* Graph operations */
+
+static void
+BM_GraphAddEdge(benchmark::State& state)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(make_grid(get_side(state)));
+  }
+  state.SetComplexityN(state.range(0) * state.range(0));
+}
+BENCHMARK(BM_GraphAddEdge)->RangeMultiplier(2)->Range(8, 64)->Complexity();
+
+static void
+BM_GraphHasEdge(benchmark::State& state)
+{
+  const auto side = get_side(state);
+  const auto graph = make_grid(side);
+  for (auto _ : state) {
+    for (unsigned id = 0; id + 1 < side * side; id++) {
+      benchmark::DoNotOptimize(graph.has_edge(id, id + 1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (side * side - 1));
+}
+BENCHMARK(BM_GraphHasEdge)->RangeMultiplier(2)->Range(8, 64);
+
+static void
+BM_GraphGetNeighbours(benchmark::State& state)
+{
+  const auto side = get_side(state);
+  const auto graph = make_grid(side);
+  const auto center = side / 2 + side / 2 * side;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(graph.get_neighbours(center));
+  }
+  state.SetComplexityN(state.range(0) * state.range(0));
+}
+BENCHMARK(BM_GraphGetNeighbours)
+  ->RangeMultiplier(2)
+  ->Range(8, 64)
+  ->Complexity();
+
+/* Graph algorithms (on grids) */
+
+static void
+BM_ReachableNodes(benchmark::State& state)
+{
+  const auto graph = make_grid(get_side(state));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::graph_algorithms::reachable_nodes(graph, 0u));
+  }
+  state.SetComplexityN(state.range(0) * state.range(0));
+}
+BENCHMARK(BM_ReachableNodes)->RangeMultiplier(2)->Range(4, 32)->Complexity();
+
+static void
+BM_HasCircle(benchmark::State& state)
+{
+  const auto graph = make_grid(get_side(state));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::graph_algorithms::has_circle(graph));
+  }
+}
+BENCHMARK(BM_HasCircle)->RangeMultiplier(2)->Range(8, 64);
+
+static void
+BM_MakeReflexive(benchmark::State& state)
+{
+  const auto graph = make_grid(get_side(state));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::graph_algorithms::make_reflexive(graph));
+  }
+}
+BENCHMARK(BM_MakeReflexive)->RangeMultiplier(2)->Range(8, 64);
+
+static void
+BM_MakeSymmetric(benchmark::State& state)
+{
+  const auto graph = make_chain(get_side(state) * get_side(state));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::graph_algorithms::make_symmetric(graph));
+  }
+}
+BENCHMARK(BM_MakeSymmetric)->RangeMultiplier(2)->Range(8, 64);
+
+static void
+BM_MakeRepresentativesOfStrongComponents(benchmark::State& state)
+{
+  const auto graph = make_grid(get_side(state));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      utils::graph_algorithms::make_representatives_of_strong_components(
+        graph));
+  }
+}
+BENCHMARK(BM_MakeRepresentativesOfStrongComponents)
+  ->RangeMultiplier(2)
+  ->Range(4, 32);
+
+static void
+BM_ComputePath(benchmark::State& state)
+{
+  const auto side = get_side(state);
+  const auto graph = make_grid(side);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      utils::graph_algorithms::compute_path(graph, 0u, side * side - 1));
+  }
+  state.SetComplexityN(state.range(0) * state.range(0));
+}
+BENCHMARK(BM_ComputePath)->RangeMultiplier(2)->Range(4, 32)->Complexity();
+
+static void
+BM_ComputeShortestPath(benchmark::State& state)
+{
+  const auto side = get_side(state);
+  const auto graph = make_grid(side);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      utils::graph_algorithms::compute_shortest_path(graph, 0u, side * side - 1));
+  }
+  state.SetComplexityN(state.range(0) * state.range(0));
+}
+BENCHMARK(BM_ComputeShortestPath)
+  ->RangeMultiplier(2)
+  ->Range(4, 32)
+  ->Complexity();
+
+/* Closures (on chains, they are super-linear) */
+
+static void
+BM_MakeTransitive(benchmark::State& state)
+{
+  const auto graph = make_chain(get_side(state));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(utils::graph_algorithms::make_transitive(graph));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MakeTransitive)->RangeMultiplier(2)->Range(4, 32)->Complexity();
+
+static void
+BM_MakeStrongComponents(benchmark::State& state)
+{
+  const auto graph = make_chain(get_side(state));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      utils::graph_algorithms::make_strong_components(graph));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MakeStrongComponents)
+  ->RangeMultiplier(2)
+  ->Range(4, 32)
+  ->Complexity();
+
+/// @note Limited to 16 nodes: larger components hit std::sort's
+/// introsort with the non-strict comparator of `linearly_order_nodes`
+static void
+BM_LinearlyOrderNodes(benchmark::State& state)
+{
+  const auto graph = make_chain(get_side(state));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      utils::graph_algorithms::linearly_order_nodes(graph));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_LinearlyOrderNodes)
+  ->RangeMultiplier(2)
+  ->Range(4, 16)
+  ->Complexity();
@@ -0,0 +1,37 @@
+#include <benchmark/benchmark.h>
+
+#include <utils/metrics.hpp>
+
+/// @brief Cost of a counter increment on the hot path
+static void
+BM_CounterIncrement(benchmark::State& state)
+{
+  static const utils::Counter counter{ "benchmark_increments_total" };
+  for (auto _ : state) {
+    counter.increment();
+  }
+}
+BENCHMARK(BM_CounterIncrement)->ThreadRange(1, 8);
+
+static void
+BM_HistogramRecord(benchmark::State& state)
+{
+  static const utils::Histogram histogram{ "benchmark_values" };
+  std::uint64_t value = 1;
+  for (auto _ : state) {
+    histogram.record(value);
+    value = value * 3 % 1000003;
+  }
+}
+BENCHMARK(BM_HistogramRecord)->ThreadRange(1, 8);
+
+static void
+BM_GaugeSet(benchmark::State& state)
+{
+  static const utils::Gauge gauge{ "benchmark_gauge" };
+  std::int64_t value = 0;
+  for (auto _ : state) {
+    gauge.set(value++);
+  }
+}
+BENCHMARK(BM_GaugeSet);
@@ -0,0 +1,14 @@
+#include <benchmark/benchmark.h>
+
+#include <utils/profiler.hpp>
+
+/// @brief Cost of an (empty) zone on the hot path
+static void
+BM_ProfilerZone(benchmark::State& state)
+{
+  for (auto _ : state) {
+    const utils::Profiler::Zone zone{ "benchmark zone" };
+  }
+  utils::Profiler::get().end_frame();
+}
+BENCHMARK(BM_ProfilerZone);
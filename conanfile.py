@@ -15,7 +15,8 @@ class b0berman(ConanFile):
         "freeimage/3.18.0",
         "glm/0.9.9.8",
         "boost/1.81.0",
-        "freetype/2.13.0"
+        "freetype/2.13.0",
+        "zlib/1.2.13"
     ]
 
     generators = "CMakeDeps"
@@ -0,0 +1,44 @@
+#include <bm/animation.hpp>
+
+auto
+bm::update_animations(World& world,
+                      const TilesetRegistry& tilesets,
+                      std::chrono::microseconds delta) -> void
+{
+  for (auto& [id, entity] : world) {
+    if (not entity.tile_.animation_) {
+      continue;
+    }
+    advance_animation(entity, tilesets.get(entity.tile_.tileset_), delta);
+  }
+}
+
+auto
+bm::advance_animation(Entity& entity,
+                      const render::Tileset* tileset,
+                      std::chrono::microseconds delta) -> void
+{
+  if (not entity.tile_.animation_) {
+    return;
+  }
+  auto& animation = entity.tile_.animation_.value();
+
+  if (not tileset or tileset->animations.size() <= animation.id or
+      tileset->animations[animation.id].sequence.empty()) {
+    return;
+  }
+
+  if (animation.remaining_time > delta) {
+    animation.remaining_time -= delta;
+    return;
+  }
+
+  const auto& sequence_definition = tileset->animations[animation.id].sequence;
+  const auto keypoint_count = sequence_definition.size();
+  const auto new_keypoint_id = (animation.keypoint_id + 1) % keypoint_count;
+  const auto& keypoint_definition = sequence_definition[new_keypoint_id];
+
+  animation.keypoint_id = new_keypoint_id;
+  animation.remaining_time = keypoint_definition.duration;
+  entity.tile_.tile_index_ = keypoint_definition.tile;
+}
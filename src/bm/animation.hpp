@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+
+#include <bm/tileset_registry.hpp>
+#include <bm/world.hpp>
+
+namespace bm {
+
+/**
+ * @brief Advance tile animations of all entities in `world` by `delta`
+ *
+ * Animations of entities with non-resident tilesets (e.g. off-screen ones)
+ * are paused.
+ */
+auto
+update_animations(World& world,
+                  const TilesetRegistry& tilesets,
+                  std::chrono::microseconds delta) -> void;
+
+/// @brief Advance tile animation of `entity`, whose tileset is `tileset`
+/// (paused, when nullptr)
+auto
+advance_animation(Entity& entity,
+                  const render::Tileset* tileset,
+                  std::chrono::microseconds delta) -> void;
+
+} // namespace bm
@@ -2,9 +2,11 @@
 
 #include <bitset>
 #include <optional>
+#include <string_view>
 #include <variant>
 
 #include <bm/game_logic.hpp>
+#include <bm/tileset_handle.hpp>
 #include <glm/glm.hpp>
 #include <render/tiled_map.hpp>
 #include <utils/aabb.hpp>
@@ -81,9 +83,9 @@ public:
     aabb_.size_ = size;
     return *this;
   }
-  auto set_tileset(std::string tileset) -> Entity&
+  auto set_tileset(std::string_view tileset) -> Entity&
   {
-    tile_.tileset_name_ = tileset;
+    tile_.tileset_ = TilesetHandle{ tileset };
     return *this;
   }
 
@@ -159,13 +161,13 @@ public:
   // Visual component
   struct Tile
   {
-    std::string tileset_name_{ "default" };
+    TilesetHandle tileset_;
     render::TiledMap::TileIndex tile_index_{ 0 };
     struct Animation
     {
       unsigned int id;
       unsigned int keypoint_id;
-      std::chrono::milliseconds remaining_time;
+      std::chrono::microseconds remaining_time;
     };
     std::optional<Animation> animation_;
   } tile_;
@@ -1,16 +1,19 @@
 #pragma once
 
 #include <chrono>
+#include <optional>
 #include <queue>
 #include <typeindex>
 #include <variant>
 #include <vector>
 
 #include <boost/core/demangle.hpp>
+#include <fmt/format.h>
 #include <spdlog/spdlog.h>
 
 #include <bm/entity.hpp>
 #include <utils/extended_priority_queue.hpp>
+#include <utils/metrics.hpp>
 
 namespace bm {
 
@@ -35,6 +38,34 @@ public:
 public:
   EventDistributor() = default;
 
+  /// @brief Current time (simulated one, when set)
+  auto now() const -> Timestamp
+  {
+    return simulated_time_ ? *simulated_time_ : Clock::now();
+  }
+
+  /**
+   * @brief Plan & dispatch events in simulated time instead of wall-clock
+   *
+   * @param time Current simulated time (nullopt: follow wall-clock again)
+   */
+  auto set_simulated_time(std::optional<Timestamp> time) -> void
+  {
+    simulated_time_ = time;
+  }
+
+  /**
+   * @brief Plan `E` event for now
+   *
+   * @tparam E
+   * @param event
+   */
+  template<typename E>
+  auto enqueue_event(E event) -> void
+  {
+    enqueue_event(std::move(event), now());
+  }
+
   /**
    * @brief Plan `E` event for `planned_time`
    *
@@ -43,10 +74,12 @@ public:
    * @param planned_time
    */
   template<typename E>
-  auto enqueue_event(E event, Timestamp planned_time = Clock::now()) -> void
+  auto enqueue_event(E event, Timestamp planned_time) -> void
   {
     event_queue_.emplace(std::move(Record{
-      std::make_unique<EventModel<E>>(event), Clock::now(), planned_time }));
+      std::make_unique<EventModel<E>>(event), now(), planned_time }));
+    get_type_metrics<E>().enqueued_.increment();
+    queue_depth_.set(static_cast<std::int64_t>(event_queue_.size()));
   }
 
   /**
@@ -59,30 +92,47 @@ public:
   template<typename E>
   auto enqueue_event(E event, std::chrono::milliseconds delta) -> void
   {
-    event_queue_.emplace(
-      std::move(Record{ std::make_unique<EventModel<E>>(event),
-                        Clock::now(),
-                        Clock::now() + delta }));
+    const auto time = now();
+    event_queue_.emplace(std::move(
+      Record{ std::make_unique<EventModel<E>>(event), time, time + delta }));
+    get_type_metrics<E>().enqueued_.increment();
+    queue_depth_.set(static_cast<std::int64_t>(event_queue_.size()));
   }
 
   /// @brief Process all ready events
   auto dispatch() -> void
   {
-    const auto now = Clock::now();
+    const auto now = this->now();
+    // End of previous event's handlers (one clock read per event)
+    auto dispatch_time = Clock::now();
+    std::uint64_t backlog = 0;
     while (!event_queue_.empty() and event_queue_.top().planned_time_ <= now) {
       // Fetch top and pop (to allow enqueuing while processing current event)
       const auto record = event_queue_.top_and_pop();
+      const auto& metrics = record.event_->metrics_;
+      metrics.dispatched_.increment();
+      metrics.lateness_.record(
+        (simulated_time_ ? *simulated_time_ : dispatch_time) -
+        record.planned_time_);
+      backlog++;
 
       const auto& type_index = record.event_->type_;
       if (listeners_.count(type_index) == 0) {
         spdlog::warn("Missing handler for event with name:'{}'",
                      boost::core::demangle(type_index.name()));
+        // Warning is not part of the next event's handlers
+        dispatch_time = Clock::now();
         continue;
       }
       for (const auto& listener : listeners_.at(type_index)) {
         listener(record);
       }
+      const auto handled_time = Clock::now();
+      metrics.handler_time_.record(handled_time - dispatch_time);
+      dispatch_time = handled_time;
     }
+    backlog_.record(backlog);
+    queue_depth_.set(static_cast<std::int64_t>(event_queue_.size()));
   }
 
   template<typename E, typename... Events, typename T>
@@ -111,22 +161,54 @@ public:
   }
 
 private:
+  /// @brief Metrics of a single event type (labeled by demangled name)
+  struct TypeMetrics
+  {
+    explicit TypeMetrics(const std::string& type)
+      : enqueued_{ "events_enqueued_total", fmt::format("type=\"{}\"", type) }
+      , dispatched_{ "events_dispatched_total",
+                     fmt::format("type=\"{}\"", type) }
+      , lateness_{ "event_lateness_nanoseconds",
+                   fmt::format("type=\"{}\"", type) }
+      , handler_time_{ "event_handler_nanoseconds",
+                       fmt::format("type=\"{}\"", type) }
+    {
+    }
+
+    utils::Counter enqueued_;
+    utils::Counter dispatched_;
+    /// @brief Dispatch time minus planned time (e.g. delayed by a hitch)
+    utils::Histogram lateness_;
+    /// @brief Time spent in all handlers of an event
+    utils::Histogram handler_time_;
+  };
+
+  template<typename E>
+  static auto get_type_metrics() -> const TypeMetrics&
+  {
+    static const TypeMetrics metrics{ boost::core::demangle(
+      typeid(E).name()) };
+    return metrics;
+  }
+
   struct EventConcept
   {
-    EventConcept(std::type_index type)
+    EventConcept(std::type_index type, const TypeMetrics& metrics)
       : type_{ type }
+      , metrics_{ metrics }
     {
     }
 
     virtual ~EventConcept() = default;
     std::type_index type_;
+    const TypeMetrics& metrics_;
   };
 
   template<typename T>
   struct EventModel : public EventConcept
   {
     explicit EventModel(T data)
-      : EventConcept{ std::type_index(typeid(T)) }
+      : EventConcept{ std::type_index(typeid(T)), get_type_metrics<T>() }
       , data_{ data }
     {
     }
@@ -188,6 +270,12 @@ private:
   std::unordered_map<std::type_index,
                      std::vector<std::function<void(const Record&)>>>
     listeners_;
+
+  std::optional<Timestamp> simulated_time_;
+
+  utils::Gauge queue_depth_{ "event_queue_depth" };
+  /// @brief Ready events, processed by a single `dispatch()`
+  utils::Histogram backlog_{ "event_backlog" };
 };
 
 } // namespace bm
\ No newline at end of file
@@ -1,9 +1,13 @@
+#include <bm/animation.hpp>
 #include <bm/game.hpp>
+#include <bm/level_pack.hpp>
 
 #include <render/resource.hpp>
 #include <render/tile_program.hpp>
-#include <utils/io.hpp>
 #include <utils/json.hpp>
+#include <utils/mapped_file.hpp>
+#include <utils/metrics.hpp>
+#include <utils/profiler.hpp>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
@@ -18,12 +22,13 @@ load_tile_renderer_program(std::filesystem::path assets) -> render::Program
   // Construct tile renderer
   auto program = render::Program{};
   [&]() {
-    auto vs_shader_code = utils::read_text_file(assets / "tm.vs.glsl");
-    auto vs_shader = render::load_shader(gl::GL_VERTEX_SHADER, vs_shader_code);
+    const auto vs_shader_code = utils::MappedFile{ assets / "tm.vs.glsl" };
+    auto vs_shader =
+      render::load_shader(gl::GL_VERTEX_SHADER, vs_shader_code.get_view());
 
-    auto fs_shader_code = utils::read_text_file(assets / "tm.fg.glsl");
+    const auto fs_shader_code = utils::MappedFile{ assets / "tm.fg.glsl" };
     auto fs_shader =
-      render::load_shader(gl::GL_FRAGMENT_SHADER, fs_shader_code);
+      render::load_shader(gl::GL_FRAGMENT_SHADER, fs_shader_code.get_view());
 
     auto shaders = std::vector<render::Shader>{};
     shaders.emplace_back(std::move(vs_shader));
@@ -32,76 +37,113 @@ load_tile_renderer_program(std::filesystem::path assets) -> render::Program
   }();
   return std::move(program);
 }
+
+/// @brief Layers of render queue (drawn in ascending order)
+namespace render_layer {
+constexpr unsigned map = 0;
+constexpr unsigned entities = 1;
+constexpr unsigned hud = 2;
+constexpr unsigned count = 3;
+} // namespace render_layer
 } // namespace
 
 Game::Game(render::interfaces::IRenderable& renderable, Settings settings)
-  : Application{ renderable }
+  : Application{ renderable, settings.application }
   , settings_{ settings }
   , viewport_{}
+  , render_queue_{}
+  , gpu_timer_{}
   , tile_renderer_{ render::TileRenderer{
       viewport_,
+      render_queue_,
       load_tile_renderer_program(settings.assets_directory) } }
   , tile_map_renderer_{ render::TileMapRenderer{ tile_renderer_ } }
-  , font_renderer_{ viewport_, settings.assets_directory / "data-latin.ttf" }
+  , font_manager_{ settings.assets_directory }
+  , font_renderer_{ viewport_,
+                    render_queue_,
+                    font_manager_,
+                    "data-latin.ttf" }
   , hud_manager_{ font_renderer_ }
-  , event_distributor_{}
-  , world_{ event_distributor_ }
-  , game_controller_{ *this, event_distributor_, hud_manager_, world_ }
-  , npc_controller_{ event_distributor_, world_ }
+  , simulation_{ *this, hud_manager_.get_texts(), settings.simulation }
 {
+  std::vector<const char*> layer_names(render_layer::count);
+  layer_names[render_layer::map] = "gpu: map";
+  layer_names[render_layer::entities] = "gpu: entities";
+  layer_names[render_layer::hud] = "gpu: hud";
+  render_queue_.set_gpu_timer(&gpu_timer_, std::move(layer_names));
+
+  hud_manager_.set_frame_statistics(&get_frame_statistics());
+  hud_manager_.set_profiler_overlay(settings_.profiler_overlay);
+  if (settings_.hot_reload) {
+    asset_watcher_ =
+      std::make_unique<utils::FileWatcher>(settings_.assets_directory);
+  }
   load_level();
 }
 
 auto
 Game::get_current_level() const -> const bm::Level*
 {
-  if (level_) {
+  if (level_ and level_->map_) {
     return level_.get();
   }
   return nullptr;
 }
 
 auto
-Game::on_render(std::chrono::milliseconds delta) -> void
+Game::on_render(std::chrono::microseconds delta) -> void
 {
   /* Update world logic */
-  event_distributor_.dispatch();
-  world_.update(delta);
-  world_.delete_marked_entities();
-
-  npc_controller_.update();
+  simulation_.update(delta);
+
+  {
+    PROFILE_ZONE("assets");
+    if (level_loader_) {
+      update_level_loading();
+    } else if (asset_watcher_) {
+      reload_changed_assets();
+    }
+    if (level_) {
+      level_->tilesets_.update();
+    }
+  }
 
-  update_animations(delta);
+  if (level_) {
+    PROFILE_ZONE("animations");
+    update_animations(simulation_.world_, level_->tilesets_, delta);
+  }
 
-  /* Render the world */
-  const auto screen_size = viewport_.get_size();
-  tile_renderer_.set_projection_matrix(0, 0, screen_size[0], screen_size[1]);
+  /* Render the world (in world units, as seen by camera) */
+  update_camera();
+  const auto visible_area = viewport_.get_visible_area();
+  const auto visible_min = visible_area.get_top_left();
+  const auto visible_max = visible_area.get_bottom_right();
+  tile_renderer_.set_projection_matrix(
+    visible_min.x, visible_min.y, visible_max.x, visible_max.y);
 
-  if (level_) {
+  if (get_current_level()) {
     /* Draw static map */
+    render_queue_.set_layer(render_layer::map);
     if (level_->map_) {
+      PROFILE_ZONE("map");
       tile_map_renderer_.render(*level_->map_);
     }
 
-    const auto& default_tileset = level_->tilesets_.get_entity("default");
-    if (default_tileset) {
-      const auto tile_size = tile_map_renderer_.get_tile_size(*level_->map_);
-
+    if (level_->tilesets_.get(TilesetHandle{})) {
+      PROFILE_ZONE("entities");
       /* Draw dynamic entities */
-      for (const auto& [id, entity] : world_) {
-        const auto origin = entity.aabb_.origin_;
-        const auto size = entity.aabb_.size_;
-
-        if (not level_->tilesets_.has_entity(entity.tile_.tileset_name_)) {
-          spdlog::warn("Tileset '{}' is not loaded, using 'default'",
-                       entity.tile_.tileset_name_);
+      render_queue_.set_layer(render_layer::entities);
+      for (const auto& [id, entity] : simulation_.world_) {
+        if (not visible_area.collide(entity.aabb_)) {
+          continue;
         }
-        const auto& tileset = level_->tilesets_.value_or(
-          entity.tile_.tileset_name_, default_tileset);
+
+        // Only visible entities make their tilesets resident
+        const auto* tileset = level_->tilesets_.acquire(entity.tile_.tileset_);
 
         tile_renderer_.bind_tileset(*tileset);
         tile_renderer_.draw_quad(
-          origin * tile_size, size * tile_size, entity.tile_.tile_index_);
+          entity.aabb_.origin_, entity.aabb_.size_, entity.tile_.tile_index_);
       }
     } else {
       spdlog::error("Default tileset not defined!");
@@ -109,7 +151,38 @@ Game::on_render(std::chrono::milliseconds delta) -> void
   }
 
   /* Render overlays */
-  hud_manager_.render(delta);
+  {
+    PROFILE_ZONE("hud");
+    render_queue_.set_layer(render_layer::hud);
+    hud_manager_.render(delta);
+  }
+
+  render_queue_.submit();
+  gpu_timer_.end_frame();
+
+  update_metrics_dump(delta);
+}
+
+auto
+Game::update_metrics_dump(std::chrono::microseconds delta) -> void
+{
+  if (settings_.metrics_file.empty()) {
+    return;
+  }
+  metrics_elapsed_ += delta;
+  if (metrics_elapsed_ < settings_.metrics_interval) {
+    return;
+  }
+  metrics_elapsed_ = std::chrono::microseconds{ 0 };
+
+  // Reading merges all threads' shards, keep it (and I/O) off the frame
+  thread_pool_.submit([file = settings_.metrics_file]() {
+    try {
+      utils::MetricsRegistry::get().write_prometheus(file);
+    } catch (const std::exception& e) {
+      spdlog::warn("Failed to dump metrics: {}", e.what());
+    }
+  });
 }
 
 auto
@@ -160,20 +233,24 @@ Game::on_key_callback(int key, int scancode, int action, int mods) -> void
     }
   }();
 
-  if (movement_type and action != GLFW_REPEAT) {
-    event_distributor_.enqueue_event(bm::event::PlayerMoved{
-      *world_.get_player_id(), action == GLFW_PRESS, movement_type.value() });
+  const auto player_id = simulation_.world_.get_player_id();
+  if (movement_type and action != GLFW_REPEAT and player_id) {
+    simulation_.submit(bm::event::PlayerMoved{
+      *player_id, action == GLFW_PRESS, movement_type.value() });
   }
 
   if (key == GLFW_KEY_ENTER && action == GLFW_PRESS) {
-    if (world_.get_player_id()) {
-      event_distributor_.enqueue_event(
-        bm::event::PlayerActionEvent{ *world_.get_player_id() });
+    if (player_id) {
+      simulation_.submit(bm::event::PlayerActionEvent{ *player_id });
     }
   }
 
   if (key == GLFW_KEY_BACKSPACE && action == GLFW_PRESS) {
-    start();
+    simulation_.submit(bm::event::GameStarted{});
+  }
+
+  if (key == GLFW_KEY_F3 && action == GLFW_PRESS) {
+    hud_manager_.set_profiler_overlay(not hud_manager_.has_profiler_overlay());
   }
 
   Application::on_key_callback(key, scancode, action, mods);
@@ -189,71 +266,166 @@ Game::on_viewport_change(float x, float y, float width, float height) -> void
 auto
 Game::start() -> void
 {
-  spdlog::debug("Game::start()");
-  world_.clear();
-  event_distributor_.clear();
-
-  event_distributor_.enqueue_event(event::GameStarted{});
+  SPDLOG_DEBUG("Game::start()");
+  simulation_.start();
 }
 
 auto
 Game::load_level() -> void
 {
-  spdlog::debug("Game: initializing");
+  SPDLOG_DEBUG("Game: initializing");
   const auto& assets = settings_.assets_directory;
-  const auto level_settings = utils::read_json(assets / settings_.level);
-  level_ = std::make_unique<Level>(assets, level_settings);
-  world_.update_boundary(
-    glm::vec2(0, 0), glm::vec2(level_->map_->count_x, level_->map_->count_y));
+  const auto level_path = assets / settings_.level;
+
+  // Previous level still owns resources (via resource cache) the new level
+  // might share
+  previous_level_ = std::move(level_);
+
+  // Prefer cooked pack, fall back to JSONs when it is missing or stale
+  auto pack = LevelPack::open_if_fresh(
+    std::filesystem::path{ level_path }.replace_extension(".pack"));
+  if (pack) {
+    SPDLOG_DEBUG("Game: loading level from pack");
+    level_ = std::make_unique<Level>(pack->get_settings());
+  } else {
+    level_ = std::make_unique<Level>(utils::read_json(level_path));
+  }
+  level_->tilesets_.set_memory_budget(settings_.tileset_memory_budget);
+  level_loader_ =
+    std::make_unique<LevelLoader>(thread_pool_, assets, *level_, pack);
+}
 
-  utils::OccupancyMap2D<bool> static_collision_map{
-    { level_->map_->count_x, level_->map_->count_y }, false
-  };
+auto
+Game::update_level_loading() -> void
+{
+  const auto was_playable = level_loader_->is_playable();
+  level_loader_->poll();
 
-  const auto& tile_map =
-    std::get<render::TiledMap::TileLayer>(level_->map_->layers_.at(0).data_);
+  if (not was_playable) {
+    if (level_loader_->is_playable()) {
+      on_level_loaded();
+    } else {
+      auto& texts = hud_manager_.get_texts();
+      if (not texts.has_entity("status")) {
+        texts.create_named(
+          "status",
+          HUDManager::Text{ "", "", 48, glm::vec2(0.5, 0.5), true });
+      }
+      texts.get_entity("status")
+        .set_text(fmt::format("Loading ... {:.0f}%",
+                              level_loader_->get_progress() * 100.0f))
+        .set_fade_effect(HUDManager::Text::FadingEffect{ 1 });
+    }
+  }
 
-  std::transform(tile_map.tile_indices_.begin(),
-                 tile_map.tile_indices_.end(),
-                 static_collision_map.begin(),
-                 [](auto tile_id) { return (tile_id != 0); });
+  if (level_loader_->is_finished()) {
+    SPDLOG_DEBUG("Game: all level assets are resident");
+    level_loader_.reset();
+    previous_level_.reset();
+  }
+}
 
-  world_.update_static_collisions(std::move(static_collision_map));
+auto
+Game::on_level_loaded() -> void
+{
+  update_static_collisions();
   start();
 }
 
 auto
-Game::update_animations(std::chrono::milliseconds delta) -> void
+Game::update_static_collisions() -> void
 {
-  for (auto& [id, entity] : world_) {
-    if (entity.tile_.animation_) {
-      auto& animation = entity.tile_.animation_.value();
+  simulation_.load_static_collisions(*level_->map_);
+}
 
-      const auto& tileset_name = entity.tile_.tileset_name_;
-      if (not level_->tilesets_.has_entity(tileset_name)) {
-        continue;
-      }
+auto
+Game::reload_changed_assets() -> void
+{
+  for (const auto& file : asset_watcher_->poll()) {
+    SPDLOG_DEBUG("Game: '{}' has changed", file.c_str());
+    try {
+      reload_asset(file);
+    } catch (const std::exception& e) {
+      // Previous version stays in use until the file is fixed
+      spdlog::error("Game: failed to reload '{}': {}", file.c_str(), e.what());
+    }
+  }
+}
 
-      const auto& tileset = level_->tilesets_.get_entity(tileset_name);
-      if (tileset->animations.size() <= animation.id or
-          tileset->animations.at(animation.id).sequence.empty()) {
-        continue;
-      }
+auto
+Game::reload_asset(const std::filesystem::path& file) -> void
+{
+  const auto& assets = settings_.assets_directory;
+  if (file.filename() == "tm.vs.glsl" or file.filename() == "tm.fg.glsl") {
+    spdlog::info("Game: reloading tile renderer's program");
+    tile_renderer_.set_program(load_tile_renderer_program(assets));
+    return;
+  }
 
-      if (animation.remaining_time > delta) {
-        animation.remaining_time -= delta;
-        continue;
-      }
+  if (not level_) {
+    return;
+  }
+  level_->reload_tilesets(assets, file);
+  if (const auto previous_map = level_->reload_map(assets, file)) {
+    on_map_reloaded(*previous_map);
+  }
+}
 
-      const auto& sequence_definition =
-        tileset->animations.at(animation.id).sequence;
-      const auto keypoint_count = sequence_definition.size();
-      const auto new_keypoint_id = (animation.keypoint_id + 1) % keypoint_count;
-      const auto keypoint_definition = sequence_definition.at(new_keypoint_id);
+auto
+Game::on_map_reloaded(const render::TiledMap& previous) -> void
+{
+  const auto& map = *level_->map_;
+  if (map.count_x != previous.count_x or map.count_y != previous.count_y) {
+    // Entities stay in place, even when out of the resized map
+    update_static_collisions();
+    return;
+  }
 
-      animation.keypoint_id = new_keypoint_id;
-      animation.remaining_time = keypoint_definition.duration;
-      entity.tile_.tile_index_ = keypoint_definition.tile;
+  const auto& previous_tiles =
+    std::get<render::TiledMap::TileLayer>(previous.layers_.at(0).data_)
+      .tile_indices_;
+  const auto& tiles =
+    std::get<render::TiledMap::TileLayer>(map.layers_.at(0).data_)
+      .tile_indices_;
+
+  unsigned changed_count = 0;
+  for (std::size_t i = 0; i < tiles.size(); i++) {
+    const auto is_colliding = tiles[i] != 0;
+    if (is_colliding != (previous_tiles[i] != 0)) {
+      simulation_.world_.set_static_collision(
+        glm::uvec2(i % map.count_x, i / map.count_x), is_colliding);
+      changed_count++;
     }
   }
-}
\ No newline at end of file
+  SPDLOG_DEBUG("Game: updated {} static collision cells", changed_count);
+}
+
+auto
+Game::update_camera() -> void
+{
+  const auto screen_size = viewport_.get_size();
+  viewport_.zoom(screen_size.y / settings_.camera_visible_tiles);
+
+  if (not level_ or not level_->map_) {
+    return;
+  }
+
+  const auto map_size = glm::vec2(level_->map_->count_x, level_->map_->count_y);
+  auto target = map_size * glm::vec2(0.5);
+  if (const auto player_id = simulation_.world_.get_player_id()) {
+    target = simulation_.world_.get_entity(*player_id).aabb_.get_midpoint();
+  }
+
+  // Keep camera inside the map, center the map when smaller than screen
+  const auto visible_size = viewport_.get_visible_area().get_size();
+  glm::vec2 position;
+  for (auto axis = 0; axis < 2; axis++) {
+    position[axis] =
+      map_size[axis] <= visible_size[axis]
+        ? map_size[axis] * 0.5f
+        : glm::clamp(target[axis],
+                     visible_size[axis] * 0.5f,
+                     map_size[axis] - visible_size[axis] * 0.5f);
+  }
+  viewport_.camera_position(position);
+}
@@ -1,22 +1,26 @@
 #pragma once
+#include <chrono>
 #include <filesystem>
 #include <string>
 
 #include <nlohmann/json.hpp>
 #include <render/application.hpp>
+#include <render/font_manager.hpp>
 #include <render/font_renderer.hpp>
+#include <render/gpu_timer.hpp>
+#include <render/render_queue.hpp>
 #include <render/tile_map_renderer.hpp>
 #include <render/tile_renderer.hpp>
 #include <render/viewport.hpp>
 
 #include <bm/entity.hpp>
 #include <bm/event_distributor.hpp>
-#include <bm/game_controller.hpp>
 #include <bm/hud_manager.hpp>
 #include <bm/interfaces/game.hpp>
 #include <bm/level.hpp>
-#include <bm/npc_controller.hpp>
-#include <bm/world.hpp>
+#include <bm/simulation.hpp>
+#include <utils/file_watcher.hpp>
+#include <utils/thread_pool.hpp>
 
 namespace bm {
 
@@ -29,6 +33,21 @@ public:
   {
     std::filesystem::path assets_directory;
     std::filesystem::path level{ "levels/default.json" };
+    /// @brief Count of tile rows visible on screen (defines camera's zoom)
+    float camera_visible_tiles{ 20.0f };
+    /// @brief Reload assets (tilesets, map, shaders), when they change on disk
+    bool hot_reload{ false };
+    /// @brief Texture memory of tilesets (not drawn ones are evicted above)
+    std::size_t tileset_memory_budget{ TilesetRegistry::default_memory_budget };
+    /// @brief Show timings of frame's stages (toggled by F3)
+    bool profiler_overlay{ false };
+    /// @brief Frame pacing (target FPS & vsync)
+    render::Application::Settings application;
+    /// @brief Periodically dump metrics there (Prometheus text, empty: never)
+    std::filesystem::path metrics_file;
+    std::chrono::milliseconds metrics_interval{ 10000 };
+    /// @brief Fixed timestep, seed & recording of inputs (for replays)
+    Simulation::Settings simulation;
 
     NLOHMANN_DEFINE_TYPE_INTRUSIVE_WITH_DEFAULT(Settings, assets_directory)
   };
@@ -40,7 +59,7 @@ public:
   auto get_current_level() const -> const bm::Level* override;
 
 protected:
-  virtual auto on_render(std::chrono::milliseconds delta)
+  virtual auto on_render(std::chrono::microseconds delta)
     -> void override final;
   virtual auto on_key_callback(int key, int scancode, int action, int mods)
     -> void override final;
@@ -49,30 +68,52 @@ protected:
 
   auto start() -> void;
   auto load_level() -> void;
-  auto update_animations(std::chrono::milliseconds delta) -> void;
+  /// @brief Upload loaded assets & start the game once level is playable
+  auto update_level_loading() -> void;
+  auto on_level_loaded() -> void;
+  auto update_static_collisions() -> void;
+  /// @brief Reload assets, changed on disk since the last frame
+  auto reload_changed_assets() -> void;
+  auto reload_asset(const std::filesystem::path& file) -> void;
+  /// @brief Update static collisions of cells, which differ from `previous`
+  auto on_map_reloaded(const render::TiledMap& previous) -> void;
+  auto update_camera() -> void;
+  /// @brief Dump metrics (in background), once per `metrics_interval`
+  auto update_metrics_dump(std::chrono::microseconds delta) -> void;
 
 private:
   Settings settings_;
 
   render::Viewport viewport_;
+  /// @brief Draw commands of current frame (submitted at the end of frame)
+  render::RenderQueue render_queue_;
+  /// @brief GPU time of render queue's layers
+  render::GpuTimer gpu_timer_;
   render::TileRenderer tile_renderer_;
   render::TileMapRenderer tile_map_renderer_;
+  render::FontManager font_manager_;
   render::FontRenderer font_renderer_;
 
   HUDManager hud_manager_;
-  EventDistributor event_distributor_;
 
-  /// @brief Pool of dynamic entities
-  World world_;
+  /// @brief World, events & game logic
+  Simulation simulation_;
 
-  /// @brief Manages game dynamics (update of entites & map)
-  GameController game_controller_;
-
-  /// @brief Manages NPC's logic
-  NPCController npc_controller_;
+  /// @brief Workers for asset loading
+  utils::ThreadPool thread_pool_;
 
   /// @brief Owns current game map / multimedia resources
   std::unique_ptr<Level> level_;
+  /// @brief Kept alive while `level_` loads, so that shared assets are reused
+  std::unique_ptr<Level> previous_level_;
+  /// @brief Streams assets into `level_` (until all are resident)
+  std::unique_ptr<LevelLoader> level_loader_;
+
+  /// @brief Watches assets directory (with hot reload only)
+  std::unique_ptr<utils::FileWatcher> asset_watcher_;
+
+  /// @brief Time since metrics have been dumped
+  std::chrono::microseconds metrics_elapsed_{ 0 };
 };
 
 } // namespace bm
\ No newline at end of file
@@ -13,6 +13,31 @@ struct pair_hash
 };
 } // namespace
 
+auto
+GameController::seed(std::uint32_t seed) -> void
+{
+  random_generator_.seed(seed);
+  fire_generator_.seed(seed);
+}
+
+template<typename F>
+auto
+GameController::spawn_from_layer(const std::string& layer_name, F spawn)
+  -> bool
+{
+  const auto level = game_.get_current_level();
+  if (not level or not level->map_->has_layer(layer_name)) {
+    return false;
+  }
+  const auto& layer = level->map_->get_layer(layer_name);
+  if (std::holds_alternative<render::TiledMap::TileLayer>(layer.data_)) {
+    const auto& tile_layer = std::get<render::TiledMap::TileLayer>(layer.data_);
+    level->map_->iterate_tile_layer(
+      tile_layer, [&](auto position, auto) { spawn(glm::vec2(position)); });
+  }
+  return true;
+}
+
 auto
 GameController::handle(const event::GameStarted& event) -> void
 {
@@ -26,47 +51,32 @@ GameController::handle(const event::GameStarted& event) -> void
     .set_collision_mask_bit(Entity::Type::crate)
     .set_tileset("characters/farmer.json")
     .set_tile(2)
-    .set_origin({ 5, 0 })
+    .set_origin(spawn_position)
     .set_size({ 0.7, 0.7 })
     .set_max_speed(10.0f)
     .set_data(PlayerData{});
+  const auto player_id = *world_.get_player_id();
+
+  const auto has_npcs =
+    spawn_from_layer(npcs_layer_name, [&](glm::vec2 position) {
+      spawn_npc(position, player_id);
+    });
+  if (not has_npcs) {
+    spawn_npc(spawn_position, player_id);
+  }
 
-  world_.create(Entity::Type::npc)
-    .set_flags(Entity::Flags::animated_movement)
-    .set_collision_mask_bit(Entity::Type::player)
-    .set_collision_mask_bit(Entity::Type::bomb)
-    .set_collision_mask_bit(Entity::Type::crate)
-    .set_tileset("characters/farmer.json")
-    .set_tile(2)
-    .set_origin({ 5, 0 })
-    .set_size({ 0.7, 0.7 })
-    .set_max_speed(5.0f)
-    .set_data(NPCData{ NPCState::chasing_target, *world_.get_player_id() });
-
-  if (auto level = game_.get_current_level()) {
-    const auto boxes_layer_name = "boxes";
-    if (not level->map_->has_layer(boxes_layer_name)) {
-      spdlog::error("Missing layer {} that defines positions of boxes!",
-                    boxes_layer_name);
-    } else {
-      const auto& layer = level->map_->get_layer(boxes_layer_name);
-      if (std::holds_alternative<render::TiledMap::TileLayer>(layer.data_)) {
-        const auto& tile_layer =
-          std::get<render::TiledMap::TileLayer>(layer.data_);
-
-        level->map_->iterate_tile_layer(
-          tile_layer,
-          [&](auto position, auto index) { spawn_crate(glm::vec2(position)); });
-      }
-    }
+  const auto has_boxes = spawn_from_layer(
+    boxes_layer_name, [&](glm::vec2 position) { spawn_crate(position); });
+  if (not has_boxes and game_.get_current_level()) {
+    spdlog::error("Missing layer {} that defines positions of boxes!",
+                  boxes_layer_name);
   }
 
-  hud_manager_.get_texts().clear();
-  hud_manager_.get_texts().create_named(
-    "status", HUDManager::Text{ "", "", 10, glm::vec2(0.5, 0.5), true });
+  texts_.clear();
+  texts_.create_named(
+    "status", HUDManager::Text{ "", "", 48, glm::vec2(0.5, 0.5), true });
 
-  hud_manager_.get_texts()
-    .get_or_create_default("status")
+  texts_.get_or_create_default("status")
     .set_text("Okay, let's go!")
     .set_fade_effect(HUDManager::Text::FadingEffect(2));
 }
@@ -95,7 +105,7 @@ GameController::handle(const event::PlayerMoved& event) -> void
       player, event.direction_, event.should_accelerate);
 
   } else {
-    spdlog::debug("Missing player entity ingame");
+    SPDLOG_DEBUG("Missing player entity ingame");
   }
 }
 
@@ -128,8 +138,7 @@ GameController::handle(const event::PlayerDied& event) -> void
                                      500ms);
   }
 
-  hud_manager_.get_texts()
-    .get_or_create_default("status")
+  texts_.get_or_create_default("status")
     .set_text("Game over, bastard!")
     .set_fade_effect(HUDManager::Text::FadingEffect{ 2 })
     .set_wave_effect(HUDManager::Text::WaveEffect{ 0, 3 });
@@ -146,7 +155,7 @@ GameController::handle(const event::ParticleDestroyed& event) -> void
 
   auto& crate = world_.get_entity(event.actor_);
   crate.set_flags(Entity::Flags::marked_for_destruction);
-  spdlog::trace("particle {} destroyed", event.actor_);
+  SPDLOG_TRACE("particle {} destroyed", event.actor_);
 }
 
 auto
@@ -158,7 +167,7 @@ GameController::handle(const event::CrateDestroyed& event) -> void
 
   auto& crate = world_.get_entity(event.actor_);
   crate.set_flags(Entity::Flags::marked_for_destruction);
-  spdlog::trace("Crate {} destroyed", event.actor_);
+  SPDLOG_TRACE("Crate {} destroyed", event.actor_);
 
   std::uniform_real_distribution<> pickup_type_distribution(0, 1);
   const auto probability = pickup_type_distribution(random_generator_);
@@ -188,7 +197,6 @@ GameController::handle(const event::BombExploded& event) -> void
 
   bomb.flags_.set(Entity::Flags::marked_for_destruction);
 
-  std::default_random_engine generator;
   std::normal_distribution<float> distribution(
     constants::fire_effect_duration_mean_ms,
     constants::fire_effect_duration_sigma_ms);
@@ -216,8 +224,9 @@ GameController::handle(const event::BombExploded& event) -> void
 
       using namespace std::chrono_literals;
       const auto duration =
-        1000ms +
-        std::chrono::milliseconds{ static_cast<int>(distribution(generator)) };
+        1000ms + std::chrono::milliseconds{
+          static_cast<int>(distribution(fire_generator_))
+        };
 
       spawn_temporary_fire(pose, duration);
       if (affects_dynamic_object) {
@@ -226,10 +235,9 @@ GameController::handle(const event::BombExploded& event) -> void
     }
   }
 
-  spdlog::trace("Bomb exploded with range: {}", spawn_range);
+  SPDLOG_TRACE("Bomb exploded with range: {}", spawn_range);
 
-  hud_manager_.get_texts()
-    .get_or_create_default("status")
+  texts_.get_or_create_default("status")
     .set_text("Bomb exploded!")
     .set_fade_effect(HUDManager::Text::FadingEffect{ 1 })
     .set_wave_effect(HUDManager::Text::WaveEffect{ 0, 5 });
@@ -260,7 +268,7 @@ GameController::handle(const event::PlayerActionEvent& event) -> void
       case WeaponType::bomb: {
 
         if (not player_data.available_bomb_count_) {
-          spdlog::trace("Player has zero available bombs, skipping plant");
+          SPDLOG_TRACE("Player has zero available bombs, skipping plant");
           return;
         }
 
@@ -268,17 +276,16 @@ GameController::handle(const event::PlayerActionEvent& event) -> void
         spawn_bomb(coords, player_data.bomb_prototype_, player_id);
         player_data.available_bomb_count_--;
 
-        hud_manager_.get_texts()
-          .get_or_create_default("status")
+        texts_.get_or_create_default("status")
           .set_text("Bomb planted!")
           .set_fade_effect(HUDManager::Text::FadingEffect{ 1 })
           .set_wave_effect(HUDManager::Text::WaveEffect{ 0, 5 });
       } break;
       case WeaponType::immediate_fire: {
-        spdlog::trace("immediate_fire not implemented");
+        SPDLOG_TRACE("immediate_fire not implemented");
       } break;
       case WeaponType::flood_bomb: {
-        spdlog::trace("flood_bomb not implemented");
+        SPDLOG_TRACE("flood_bomb not implemented");
       } break;
     }
   }
@@ -338,7 +345,7 @@ GameController::handle(const event::EntityCollide& event) -> void
           event_distributor_.enqueue_event(
             event::PickedPickupItem{ pickup.get_id(), player.get_id() });
 
-          spdlog::debug("Picked up a pickup");
+          SPDLOG_DEBUG("Picked up a pickup");
         } },
       { { Entity::Type::fire, Entity::Type::player },
         [&](Entity& fire, Entity& player) {
@@ -384,7 +391,7 @@ GameController::spawn_bomb(glm::vec2 position,
   event_distributor_.enqueue_event(event::BombExploded{ entity.get_id() },
                                    2000ms);
 
-  spdlog::trace("spawn_bomb at ({}, {})", position.x, position.y);
+  SPDLOG_TRACE("spawn_bomb at ({}, {})", position.x, position.y);
   return entity;
 }
 
@@ -396,7 +403,26 @@ GameController::spawn_crate(glm::vec2 position) -> Entity&
                    .set_tileset("crate.json")
                    .set_origin(position)
                    .set_flags(Entity::Flags::frozen);
-  spdlog::trace("spawn_crate: pose ({}, {})", position.x, position.y);
+  SPDLOG_TRACE("spawn_crate: pose ({}, {})", position.x, position.y);
+  return entity;
+}
+
+auto
+GameController::spawn_npc(glm::vec2 position, Entity::Id target) -> Entity&
+{
+  using namespace bm::game_logic;
+  auto& entity = world_.create(Entity::Type::npc)
+                   .set_flags(Entity::Flags::animated_movement)
+                   .set_collision_mask_bit(Entity::Type::player)
+                   .set_collision_mask_bit(Entity::Type::bomb)
+                   .set_collision_mask_bit(Entity::Type::crate)
+                   .set_tileset("characters/farmer.json")
+                   .set_tile(2)
+                   .set_origin(position)
+                   .set_size({ 0.7, 0.7 })
+                   .set_max_speed(5.0f)
+                   .set_data(NPCData{ NPCState::chasing_target, target });
+  SPDLOG_TRACE("spawn_npc: pose ({}, {})", position.x, position.y);
   return entity;
 }
 
@@ -419,10 +445,10 @@ GameController::spawn_pickup(glm::vec2 position, game_logic::PickupType type)
                    .set_tileset("potions.json")
                    .set_origin(position)
                    .set_data(game_logic::PickupData{ type });
-  spdlog::trace("spawn_pickup: pose ({}, {}), type: {}",
-                position.x,
-                position.y,
-                static_cast<unsigned>(type));
+  SPDLOG_TRACE("spawn_pickup: pose ({}, {}), type: {}",
+               position.x,
+               position.y,
+               static_cast<unsigned>(type));
   return pickup;
 }
 
@@ -439,10 +465,10 @@ GameController::spawn_temporary_fire(glm::vec2 position,
 
   event_distributor_.enqueue_event(event::FireTerminated{ fire_id }, duration);
 
-  spdlog::trace("spawn_temporary_fire: pose ({}, {}), duration: {}",
-                position.x,
-                position.y,
-                duration.count());
+  SPDLOG_TRACE("spawn_temporary_fire: pose ({}, {}), duration: {}",
+               position.x,
+               position.y,
+               duration.count());
   return world_.get_entity(fire_id);
 }
 
@@ -460,10 +486,10 @@ GameController::spawn_particle(glm::vec2 position,
   event_distributor_.enqueue_event(
     event::ParticleDestroyed{ particle.get_id() }, duration);
 
-  spdlog::trace("spawn_particle: pose ({}, {}), duration: {}",
-                position.x,
-                position.y,
-                duration.count());
+  SPDLOG_TRACE("spawn_particle: pose ({}, {}), duration: {}",
+               position.x,
+               position.y,
+               duration.count());
   return particle;
 }
 
@@ -484,8 +510,9 @@ GameController::set_entity_move_animation(
     }
   };
 
-  std::array<std::string,
-             static_cast<unsigned>(event::PlayerMoved::MoveDirection::count)>
+  static constexpr std::array<
+    const char*,
+    static_cast<unsigned>(event::PlayerMoved::MoveDirection::count)>
     directionString = {
       "up",
       "down",
@@ -500,9 +527,9 @@ GameController::set_entity_move_animation(
     &entity.controller_.moving_left,
   };
 
-  spdlog::trace("NPC moved {}, should_accelerate{}",
-                directionString[static_cast<unsigned>(moveType)],
-                should_accelerate);
+  SPDLOG_TRACE("NPC moved {}, should_accelerate{}",
+               directionString[static_cast<unsigned>(moveType)],
+               should_accelerate);
 
   *moving_direction_flag[static_cast<unsigned>(moveType)] = should_accelerate;
 
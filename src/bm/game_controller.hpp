@@ -23,13 +23,22 @@ class GameController
 {
 
 public:
+  using Texts = utils::EntityNamedRegistry<HUDManager::Text>;
+
+  /// @brief Player's (and default NPC's) position at the start of a match
+  inline static const glm::vec2 spawn_position{ 5, 0 };
+  /// @brief Level's tile layers, which define positions of crates & NPCs
+  /// @note Without NPC layer, a single NPC spawns at `spawn_position`
+  static constexpr auto boxes_layer_name = "boxes";
+  static constexpr auto npcs_layer_name = "npcs";
+
   GameController(bm::interfaces::IGame& game,
                  EventDistributor& event_distributor,
-                 HUDManager& hud_manager,
+                 Texts& texts,
                  World& world)
     : game_{ game }
     , event_distributor_{ event_distributor }
-    , hud_manager_{ hud_manager }
+    , texts_{ texts }
     , world_{ world }
   {
     event_distributor_.registry_listener<event::GameStarted,
@@ -47,6 +56,9 @@ public:
   }
 
 public:
+  /// @brief Restart random generators (e.g. for reproducible matches)
+  auto seed(std::uint32_t seed) -> void;
+
   auto handle(const event::GameStarted& event) -> void;
   auto handle(const event::DeleteEntity& event) -> void;
   auto handle(const event::PlayerMoved& event) -> void;
@@ -65,6 +77,7 @@ protected:
                   game_logic::BombPrototype type = {},
                   std::optional<Entity::Id> parent = std::nullopt) -> Entity&;
   auto spawn_crate(glm::vec2 position) -> Entity&;
+  auto spawn_npc(glm::vec2 position, Entity::Id target) -> Entity&;
   auto spawn_pickup(glm::vec2 position, game_logic::PickupType type) -> Entity&;
 
   auto spawn_temporary_fire(glm::vec2 position,
@@ -82,6 +95,11 @@ protected:
   auto compute_random_pickup_type() -> bm::game_logic::PickupType;
 
 private:
+  /// @brief Call `spawn` at each tile of level's layer (when there is one)
+  /// @return False when level lacks the layer
+  template<typename F>
+  auto spawn_from_layer(const std::string& layer_name, F spawn) -> bool;
+
   template<typename... Args>
   auto entity_exist(Entity::Id id, Args... args) -> bool;
 
@@ -89,9 +107,12 @@ private:
   bm::interfaces::IGame& game_;
   EventDistributor& event_distributor_;
 
-  HUDManager& hud_manager_;
+  /// @brief Texts of HUD (e.g. status messages)
+  Texts& texts_;
   World& world_;
 
   std::mt19937 random_generator_;
+  /// @brief Durations of fires
+  std::default_random_engine fire_generator_;
 };
 } // namespace bm
\ No newline at end of file
@@ -1,14 +1,23 @@
 #include <bm/hud_manager.hpp>
 
+#include <fmt/format.h>
+#include <utils/profiler.hpp>
+
 using namespace bm;
 
+namespace {
+/// @brief Period of refreshing profiler's overlay
+constexpr auto profiler_refresh_period = std::chrono::milliseconds{ 250 };
+constexpr auto profiler_font_size = 16.0f;
+} // namespace
+
 HUDManager::HUDManager(render::FontRenderer& font_render)
   : font_render_{ font_render }
 {
 }
 
 auto
-HUDManager::render(std::chrono::milliseconds delta) -> void
+HUDManager::render(std::chrono::microseconds delta) -> void
 {
   for (auto& [id, entity] : texts_) {
     if (entity.fading_effect_) {
@@ -20,15 +29,39 @@ HUDManager::render(std::chrono::milliseconds delta) -> void
     }
   }
 
-  for (const auto [id, entity] : texts_) {
+  for (auto& [id, entity] : texts_) {
     if (entity.fading_effect_ && entity.fading_effect_->is_text_visible()) {
+      if (not entity.layout_) {
+        entity.layout_ = font_render_.create_text_layout(
+          entity.text_, entity.font_, entity.font_size_);
+      }
+
+      auto style = render::TextStyle{};
+      style.opacity = entity.fading_effect_->get_opacity();
+      if (entity.wave_effect_) {
+        style.wave_phase = entity.wave_effect_->phase;
+        style.wave_amplitude = Text::WaveEffect::amplitude;
+      }
+
+      font_render_.draw_text(
+        *entity.layout_, entity.position_, entity.is_position_relative_, style);
+    }
+  }
+
+  if (has_profiler_overlay_) {
+    since_profiler_refresh_ += delta;
+    if (since_profiler_refresh_ >= profiler_refresh_period) {
+      since_profiler_refresh_ = {};
+      update_profiler_overlay();
+    }
 
-      const auto position =
-        entity.wave_effect_
-          ? entity.wave_effect_->apply_effect(entity.position_)
-          : entity.position_;
+    for (auto& line : profiler_lines_) {
+      if (not line.layout_) {
+        line.layout_ = font_render_.create_text_layout(
+          line.text_, line.font_, line.font_size_);
+      }
       font_render_.draw_text(
-        entity.text_, position, entity.is_position_relative_);
+        *line.layout_, line.position_, line.is_position_relative_);
     }
   }
 }
@@ -37,4 +70,60 @@ auto
 HUDManager::get_texts() -> utils::EntityNamedRegistry<Text>&
 {
   return texts_;
-}
\ No newline at end of file
+}
+auto
+HUDManager::set_profiler_overlay(bool is_visible) -> void
+{
+  has_profiler_overlay_ = is_visible;
+  if (is_visible) {
+    update_profiler_overlay();
+  } else {
+    profiler_lines_.clear();
+  }
+}
+
+auto
+HUDManager::update_profiler_overlay() -> void
+{
+  using Milliseconds = std::chrono::duration<float, std::milli>;
+  const auto to_milliseconds = [](auto duration) {
+    return std::chrono::duration_cast<Milliseconds>(duration).count();
+  };
+
+  std::vector<std::string> lines;
+  if (frame_statistics_) {
+    const auto frames = frame_statistics_->get_summary();
+    lines.push_back(
+      fmt::format("{:<20} {:6.2f} ms (p95 {:6.2f}, p99 {:6.2f}, max {:6.2f})",
+                  "frame p50",
+                  to_milliseconds(frames.p50_),
+                  to_milliseconds(frames.p95_),
+                  to_milliseconds(frames.p99_),
+                  to_milliseconds(frames.max_)));
+  }
+  for (const auto& zone : utils::Profiler::get().get_statistics()) {
+    auto line = fmt::format("{:<20} {:6.2f} ms (max {:6.2f} ms)",
+                            zone.name_,
+                            to_milliseconds(zone.average_),
+                            to_milliseconds(zone.maximum_));
+    if (utils::AllocationTracker::is_enabled) {
+      line += fmt::format(" {:5} allocs (max {})",
+                          zone.allocations_,
+                          zone.maximum_allocations_);
+    }
+    lines.push_back(std::move(line));
+  }
+
+  while (profiler_lines_.size() < lines.size()) {
+    const auto row = static_cast<float>(profiler_lines_.size());
+    profiler_lines_.push_back(Text{ "",
+                                    "",
+                                    profiler_font_size,
+                                    glm::vec2(0.01f, 0.03f + row * 0.03f),
+                                    true });
+  }
+
+  for (std::size_t i = 0; i < lines.size(); i++) {
+    profiler_lines_[i].set_text(std::move(lines[i]));
+  }
+}
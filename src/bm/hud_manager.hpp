@@ -1,9 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
+#include <memory>
 #include <optional>
+#include <vector>
 
 #include <render/font_renderer.hpp>
+#include <render/frame_statistics.hpp>
 #include <utils/entity_registry.hpp>
 
 namespace bm {
@@ -26,12 +30,16 @@ public:
       {
       }
 
-      auto update(std::chrono::milliseconds delta) -> void
+      auto update(std::chrono::microseconds delta) -> void
       {
-        const auto rate_per_millisecond = fade_delta / 1000.0f;
-        fade_percentage += delta.count() * rate_per_millisecond;
+        const auto rate_per_microsecond = fade_delta / 1e6f;
+        fade_percentage += delta.count() * rate_per_microsecond;
       }
       auto is_text_visible() const -> bool { return fade_percentage < 1.0; }
+      auto get_opacity() const -> float
+      {
+        return std::clamp(1.0f - fade_percentage, 0.0f, 1.0f);
+      }
     };
 
     struct WaveEffect
@@ -40,16 +48,13 @@ public:
       float phase;
       /// Radians (of phase) per second
       float effect_delta;
+      /// @brief Amplitude (relative to text's position)
+      static constexpr float amplitude{ 0.1f };
 
-      auto update(std::chrono::milliseconds delta) -> void
-      {
-        const auto rate_per_millisecond = effect_delta / 1000.0f;
-        phase += delta.count() * rate_per_millisecond;
-      }
-
-      auto apply_effect(glm::vec2 position) const -> glm::vec2
+      auto update(std::chrono::microseconds delta) -> void
       {
-        return glm::vec2(position.x, position.y *= 1.0 + 0.1 * std::sin(phase));
+        const auto rate_per_microsecond = effect_delta / 1e6f;
+        phase += delta.count() * rate_per_microsecond;
       }
     };
 
@@ -57,7 +62,9 @@ public:
     using Id = std::string;
 
     std::string text_;
+    /// @brief Font name (empty: renderer's default font)
     std::string font_;
+    /// @brief Font size (in pixels)
     float font_size_;
 
     /* Position */
@@ -68,9 +75,23 @@ public:
     std::optional<FadingEffect> fading_effect_;
     std::optional<WaveEffect> wave_effect_;
 
+    /// @brief Cached glyph quads (invalidated when text or font changes)
+    std::shared_ptr<render::FontRenderer::TextLayout> layout_;
+
     auto set_text(std::string text) -> Text&
     {
-      text_ = text;
+      if (text != text_) {
+        text_ = text;
+        layout_.reset();
+      }
+      return *this;
+    }
+
+    auto set_font(std::string font, float font_size) -> Text&
+    {
+      font_ = font;
+      font_size_ = font_size;
+      layout_.reset();
       return *this;
     }
 
@@ -89,12 +110,31 @@ public:
 
   explicit HUDManager(render::FontRenderer& font_render);
 
-  auto render(std::chrono::milliseconds delta) -> void;
+  auto render(std::chrono::microseconds delta) -> void;
   auto get_texts() -> utils::EntityNamedRegistry<Text>&;
 
+  /// @brief Show rolling averages of profiler's zones (top-left corner)
+  auto set_profiler_overlay(bool is_visible) -> void;
+  auto has_profiler_overlay() const -> bool { return has_profiler_overlay_; }
+  /// @brief Show percentiles of frame times (atop profiler's zones)
+  auto set_frame_statistics(const render::FrameStatistics* statistics)
+    -> void
+  {
+    frame_statistics_ = statistics;
+  }
+
 private:
+  auto update_profiler_overlay() -> void;
+
   render::FontRenderer& font_render_;
   utils::EntityNamedRegistry<Text> texts_;
+
+  bool has_profiler_overlay_{ false };
+  const render::FrameStatistics* frame_statistics_{ nullptr };
+  /// @brief A line per zone (refreshed periodically, as each change of text
+  /// lays it out again)
+  std::vector<Text> profiler_lines_;
+  std::chrono::microseconds since_profiler_refresh_{ 0 };
 };
 
 } // namespace bm
\ No newline at end of file
@@ -1,24 +1,243 @@
 #include <bm/level.hpp>
+#include <bm/level_pack.hpp>
+
+#include <algorithm>
+#include <chrono>
+
 #include <spdlog/spdlog.h>
+#include <utils/json.hpp>
+#include <utils/profiler.hpp>
+#include <utils/resource_cache.hpp>
 
 using namespace bm;
 
+namespace {
+template<typename T>
+auto
+is_ready(const std::future<T>& future) -> bool
+{
+  return future.valid() and future.wait_for(std::chrono::seconds(0)) ==
+                              std::future_status::ready;
+}
+
+/// @brief Parse map, or share the resident one
+auto
+load_shared_map(const std::filesystem::path& file)
+  -> std::shared_ptr<const render::TiledMap>
+{
+  auto& maps = utils::ResourceCache<const render::TiledMap>::get();
+  const auto key = utils::ResourceKey::from_file(file);
+  if (auto map = maps.find(key)) {
+    return map;
+  }
+  return maps.insert(key, render::TiledMap::load_map(file, nullptr));
+}
+
+/// @brief Decoder of level's tilesets (from pack when cooked there)
+auto
+make_tileset_decoder(std::filesystem::path assets_directory,
+                     std::string default_tileset,
+                     std::shared_ptr<const LevelPack> pack)
+{
+  return [assets = std::move(assets_directory),
+          default_tileset = std::move(default_tileset),
+          pack = std::move(pack)](const std::string& name) {
+    PROFILE_ZONE("decode tileset");
+    if (pack) {
+      for (const auto& tileset : pack->get_tilesets()) {
+        if (tileset.name_ == name) {
+          return tileset.tileset_;
+        }
+      }
+    }
+    const auto path = name == TilesetRegistry::fallback_name
+                        ? assets / default_tileset
+                        : assets / name;
+    SPDLOG_TRACE("Loading tileset '{}'", path.c_str());
+    return render::Tileset::decode_tileset(path);
+  };
+}
+
+auto
+is_same_file(const std::filesystem::path& a, const std::filesystem::path& b)
+  -> bool
+{
+  std::error_code error;
+  return std::filesystem::equivalent(a, b, error);
+}
+} // namespace
+
+Level::Level(Level::Settings settings)
+  : settings_{ std::move(settings) }
+{
+}
+
 Level::Level(std::filesystem::path assets_directory, Level::Settings settings)
   : settings_{ settings }
+{
+  utils::ThreadPool pool;
+  LevelLoader{ pool, assets_directory, *this }.wait();
+
+  // Tilesets, used later on, can't be loaded on the temporary pool
+  tilesets_.set_load_function(
+    [decode = make_tileset_decoder(
+       assets_directory, settings_.tileset_name, nullptr)](
+      const std::string& name) {
+      return std::async(std::launch::async, decode, name);
+    });
+}
+
+auto
+Level::reload_tilesets(const std::filesystem::path& assets_directory,
+                       const std::filesystem::path& file) -> unsigned
+{
+  unsigned count = 0;
+  for (const auto handle : tilesets_.get_resident()) {
+    const auto& name = handle.get_name();
+    const auto definition =
+      assets_directory /
+      (handle.is_default() ? settings_.tileset_name : name);
+
+    auto is_affected = is_same_file(file, definition);
+    if (not is_affected) {
+      // Image of a packed tileset is not known without its definition
+      auto image = tilesets_.get(handle)->image_path_;
+      if (image.empty()) {
+        try {
+          image = definition.parent_path() /
+                  utils::read_json(definition).at("image").get<std::string>();
+        } catch (const std::exception& e) {
+          // Unrelated broken definition doesn't stop reloads of the others
+          spdlog::warn("Level: skipping tileset '{}': {}", name, e.what());
+          continue;
+        }
+      }
+      is_affected = is_same_file(file, image);
+    }
+
+    if (is_affected) {
+      spdlog::info("Level: reloading tileset '{}'", name);
+      tilesets_.insert(
+        handle, render::Tileset::load_tileset(definition), handle.is_default());
+      count++;
+    }
+  }
+
+  if (count > 0 and map_) {
+    map_->tileset_ = tilesets_.find(TilesetHandle{});
+  }
+  return count;
+}
 
+auto
+Level::reload_map(const std::filesystem::path& assets_directory,
+                  const std::filesystem::path& file)
+  -> std::shared_ptr<render::TiledMap>
 {
-  const auto& assets = assets_directory;
+  if (not map_ or
+      not is_same_file(file, assets_directory / settings_.tilemap_path)) {
+    return nullptr;
+  }
+
+  spdlog::info("Level: reloading map '{}'", settings_.tilemap_path);
+  parsed_map_ = load_shared_map(file);
+  auto previous = std::move(map_);
+  map_ = std::make_shared<render::TiledMap>(*parsed_map_);
+  map_->tileset_ = previous->tileset_;
+  return previous;
+}
 
-  // Load initial tile texture and map
-  spdlog::trace("Loading tileset '{}'", settings.tileset_name.c_str());
-  auto tileset = render::Tileset::load_tileset(assets / settings.tileset_name);
-  map_ = render::TiledMap::load_map(assets / settings.tilemap_path, tileset);
-  tilesets_.create_named("default", tileset);
+LevelLoader::LevelLoader(utils::ThreadPool& pool,
+                         const std::filesystem::path& assets_directory,
+                         Level& level,
+                         std::shared_ptr<const LevelPack> pack)
+  : level_{ level }
+{
+  const auto decode =
+    make_tileset_decoder(assets_directory, level_.settings_.tileset_name, pack);
 
-  // Load tilesets
-  for (const auto& tileset_path : settings.tilesets) {
-    spdlog::trace("Loading tileset '{}'", tileset_path);
-    auto tileset = render::Tileset::load_tileset(assets / tileset_path);
-    tilesets_.create_named(tileset_path, tileset);
+  // Map only stores a pointer to its tileset, so both load in parallel
+  pending_tilesets_.push_back(PendingTileset{
+    TilesetRegistry::fallback_name,
+    pool.submit([decode]() { return decode(TilesetRegistry::fallback_name); }) });
+  if (pack) {
+    pending_map_ = pool.submit([pack]() {
+      return std::shared_ptr<const render::TiledMap>{ pack->get_map() };
+    });
+  } else {
+    pending_map_ =
+      pool.submit([path = assets_directory / level_.settings_.tilemap_path]() {
+        return load_shared_map(path);
+      });
   }
-}
\ No newline at end of file
+  total_count_ = pending_tilesets_.size() + 1;
+
+  level_.tilesets_.set_load_function(
+    [&pool, decode](const std::string& name) {
+      return pool.submit([decode, name]() { return decode(name); });
+    });
+}
+
+auto
+LevelLoader::poll() -> void
+{
+  for (auto& pending : pending_tilesets_) {
+    if (is_ready(pending.decoded_)) {
+      const auto handle = TilesetHandle{ pending.name_ };
+      level_.tilesets_.insert(
+        handle, pending.decoded_.get().upload(), handle.is_default());
+      resident_count_++;
+    }
+  }
+  pending_tilesets_.erase(
+    std::remove_if(pending_tilesets_.begin(),
+                   pending_tilesets_.end(),
+                   [](const auto& pending) { return not pending.decoded_.valid(); }),
+    pending_tilesets_.end());
+
+  if (is_ready(pending_map_)) {
+    // Level's map gets its own tileset, hence the copy
+    level_.parsed_map_ = pending_map_.get();
+    map_ = std::make_shared<render::TiledMap>(*level_.parsed_map_);
+    resident_count_++;
+  }
+
+  if (map_) {
+    if (auto tileset = level_.tilesets_.find(TilesetHandle{})) {
+      map_->tileset_ = std::move(tileset);
+      level_.map_ = std::move(map_);
+    }
+  }
+}
+
+auto
+LevelLoader::wait() -> void
+{
+  while (not is_finished()) {
+    for (const auto& pending : pending_tilesets_) {
+      pending.decoded_.wait();
+    }
+    if (pending_map_.valid()) {
+      pending_map_.wait();
+    }
+    poll();
+  }
+}
+
+auto
+LevelLoader::get_progress() const -> float
+{
+  return static_cast<float>(resident_count_) / total_count_;
+}
+
+auto
+LevelLoader::is_playable() const -> bool
+{
+  return level_.map_ != nullptr;
+}
+
+auto
+LevelLoader::is_finished() const -> bool
+{
+  return resident_count_ == total_count_ and is_playable();
+}
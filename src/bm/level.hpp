@@ -1,14 +1,21 @@
 #pragma once
 
 #include <filesystem>
+#include <future>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <nlohmann/json.hpp>
+#include <bm/tileset_registry.hpp>
 #include <render/tiled_map.hpp>
-#include <utils/entity_registry.hpp>
+#include <utils/thread_pool.hpp>
 
 namespace bm {
 
+// Fwd
+class LevelPack;
+
 class Level
 {
 public:
@@ -24,12 +31,85 @@ public:
   };
 
 public:
+  /// @brief Empty level, filled by `LevelLoader`
+  explicit Level(Settings settings);
+
+  /// @brief Load level synchronously
   Level(std::filesystem::path assets_directory, Settings settings);
 
+  /// @brief Reload tilesets, defined by or using `file` (on GL thread)
+  /// @return Count of reloaded tilesets
+  auto reload_tilesets(const std::filesystem::path& assets_directory,
+                       const std::filesystem::path& file) -> unsigned;
+
+  /// @brief Reload map, when it is defined by `file`
+  /// @return Previous map (nullptr when `file` is not level's map)
+  auto reload_map(const std::filesystem::path& assets_directory,
+                  const std::filesystem::path& file)
+    -> std::shared_ptr<render::TiledMap>;
+
 public:
   Settings settings_;
+  /// @brief Map (set once map and "default" tileset are resident)
   std::shared_ptr<render::TiledMap> map_;
-  utils::EntityNamedRegistry<std::shared_ptr<render::Tileset>> tilesets_;
+  /// @brief Parsed map, `map_` is copied from (shared via resource cache)
+  std::shared_ptr<const render::TiledMap> parsed_map_;
+  /// @brief Tilesets, loaded on demand ("default" is always resident)
+  TilesetRegistry tilesets_;
+};
+
+/**
+ * @brief Loads level's assets asynchronously
+ *
+ * Parsing of JSONs and decoding of images run on a thread pool, while only
+ * the texture uploads are done by `poll()` on the thread owning GL context.
+ * The level becomes playable once its map and "default" tileset are
+ * resident. Other tilesets are not loaded up front: level's
+ * `TilesetRegistry` loads them (on the same pool) once they are used.
+ *
+ * When a (fresh) cooked `LevelPack` is given, assets are taken from it instead
+ * of JSONs and images.
+ *
+ * Maps, tilesets and textures, which are still resident (e.g. owned by the
+ * previous level), are reused via `utils::ResourceCache` instead of loading
+ * them again.
+ */
+class LevelLoader
+{
+public:
+  /// @note `level` must outlive the loader
+  LevelLoader(utils::ThreadPool& pool,
+              const std::filesystem::path& assets_directory,
+              Level& level,
+              std::shared_ptr<const LevelPack> pack = nullptr);
+
+  /// @brief Move finished assets into level (non-blocking, on GL thread)
+  /// @note Rethrows errors of failed assets
+  auto poll() -> void;
+
+  /// @brief Block until the whole level is resident
+  auto wait() -> void;
+
+  /// @brief Ratio of resident assets (0: nothing, 1: everything)
+  auto get_progress() const -> float;
+  auto is_playable() const -> bool;
+  auto is_finished() const -> bool;
+
+private:
+  struct PendingTileset
+  {
+    std::string name_;
+    std::future<render::Tileset::Decoded> decoded_;
+  };
+
+  Level& level_;
+  std::vector<PendingTileset> pending_tilesets_;
+  std::future<std::shared_ptr<const render::TiledMap>> pending_map_;
+  /// @brief Map, waiting for "default" tileset
+  std::shared_ptr<render::TiledMap> map_;
+
+  std::size_t total_count_{ 0 };
+  std::size_t resident_count_{ 0 };
 };
 
-} // namespace bm
\ No newline at end of file
+} // namespace bm
@@ -0,0 +1,187 @@
+#include <bm/level_generator.hpp>
+
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <bm/game_controller.hpp>
+#include <utils/encoding.hpp>
+#include <utils/json.hpp>
+
+using namespace bm;
+
+namespace {
+/// @brief Tile layer as Tiled's JSON (base64 encoded, zlib compressed)
+auto
+encode_layer(const render::TiledMap& map,
+             const render::TiledMap::Layer& layer,
+             unsigned id) -> nlohmann::json
+{
+  const auto& indices =
+    std::get<render::TiledMap::TileLayer>(layer.data_).tile_indices_;
+
+  // Global tile IDs (0: empty) as 32-bit little-endian integers
+  std::vector<std::uint8_t> bytes;
+  bytes.reserve(indices.size() * 4);
+  for (const auto index : indices) {
+    const auto gid = index == render::TiledMap::invalid_index ? 0 : index + 1;
+    for (unsigned shift = 0; shift < 32; shift += 8) {
+      bytes.push_back(static_cast<std::uint8_t>(gid >> shift));
+    }
+  }
+
+  return { { "compression", "zlib" },
+           { "data", utils::encode_base64(utils::deflate(bytes)) },
+           { "encoding", "base64" },
+           { "height", map.count_y },
+           { "id", id },
+           { "name", layer.name_ },
+           { "opacity", 1 },
+           { "type", "tilelayer" },
+           { "visible", layer.visible_ },
+           { "width", map.count_x },
+           { "x", 0 },
+           { "y", 0 } };
+}
+} // namespace
+
+auto
+LevelGenerator::generate(const Settings& settings)
+  -> std::shared_ptr<render::TiledMap>
+{
+  const auto spawn = glm::ivec2(GameController::spawn_position);
+  if (spawn.x >= static_cast<int>(settings.width) or
+      spawn.y >= static_cast<int>(settings.height)) {
+    throw std::runtime_error(
+      fmt::format("LevelGenerator: map {}x{} doesn't contain spawn ({}, {})",
+                  settings.width,
+                  settings.height,
+                  spawn.x,
+                  spawn.y));
+  }
+  const std::pair<const char*, float> densities[] = {
+    { "wall", settings.wall_density },
+    { "crate", settings.crate_density },
+    { "NPC", settings.npc_density },
+  };
+  for (const auto& [name, density] : densities) {
+    // Precondition of std::bernoulli_distribution (NaN fails it too)
+    if (not(density >= 0.0f and density <= 1.0f)) {
+      throw std::runtime_error(fmt::format(
+        "LevelGenerator: {} density {} is out of [0, 1]", name, density));
+    }
+  }
+
+  using TileIndex = render::TiledMap::TileIndex;
+  const auto size = std::size_t{ settings.width } * settings.height;
+  std::vector<TileIndex> walls(size, floor_tile);
+  std::vector<TileIndex> crates(size, render::TiledMap::invalid_index);
+  std::vector<TileIndex> npcs(size, render::TiledMap::invalid_index);
+
+  std::mt19937 generator{ settings.seed };
+  std::bernoulli_distribution is_wall{ settings.wall_density };
+  std::bernoulli_distribution is_crate{ settings.crate_density };
+  std::bernoulli_distribution is_npc{ settings.npc_density };
+
+  for (unsigned y = 0; y < settings.height; y++) {
+    for (unsigned x = 0; x < settings.width; x++) {
+      const auto distance = std::abs(static_cast<int>(x) - spawn.x) +
+                            std::abs(static_cast<int>(y) - spawn.y);
+      if (distance <= spawn_clearance) {
+        continue;
+      }
+
+      const auto index = std::size_t{ y } * settings.width + x;
+      const auto is_pillar = x % 2 == 1 and y % 2 == 1;
+      if (is_pillar and is_wall(generator)) {
+        walls[index] = wall_tile;
+      } else if (is_crate(generator)) {
+        crates[index] = marker_tile;
+      } else if (is_npc(generator)) {
+        npcs[index] = marker_tile;
+      }
+    }
+  }
+
+  auto map = std::make_shared<render::TiledMap>();
+  map->count_x = settings.width;
+  map->count_y = settings.height;
+  map->layers_.push_back(
+    { "collisions", true, render::TiledMap::TileLayer{ std::move(walls) } });
+  map->layers_.push_back({ GameController::boxes_layer_name,
+                           false,
+                           render::TiledMap::TileLayer{ std::move(crates) } });
+  map->layers_.push_back({ GameController::npcs_layer_name,
+                           false,
+                           render::TiledMap::TileLayer{ std::move(npcs) } });
+  return map;
+}
+
+auto
+LevelGenerator::write_map(const render::TiledMap& map,
+                          const std::filesystem::path& file,
+                          const std::filesystem::path& tileset,
+                          glm::uvec2 tile_size) -> void
+{
+  auto layers = nlohmann::json::array();
+  for (const auto& layer : map.layers_) {
+    if (std::holds_alternative<render::TiledMap::TileLayer>(layer.data_)) {
+      layers.push_back(
+        encode_layer(map, layer, static_cast<unsigned>(layers.size() + 1)));
+    }
+  }
+
+  const nlohmann::json json{
+    { "compressionlevel", -1 },
+    { "height", map.count_y },
+    { "infinite", false },
+    { "layers", std::move(layers) },
+    { "nextlayerid", map.layers_.size() + 1 },
+    { "nextobjectid", 1 },
+    { "orientation", "orthogonal" },
+    { "renderorder", "right-down" },
+    { "tiledversion", "1.9.2" },
+    { "tileheight", tile_size.y },
+    { "tilesets",
+      nlohmann::json::array(
+        { { { "firstgid", 1 }, { "source", tileset.generic_string() } } }) },
+    { "tilewidth", tile_size.x },
+    { "type", "map" },
+    { "version", "1.9" },
+    { "width", map.count_x }
+  };
+  utils::write_json(file, json);
+}
+
+auto
+LevelGenerator::write_level(const Settings& settings,
+                            const std::filesystem::path& assets_directory,
+                            const std::filesystem::path& level,
+                            Level::Settings base) -> Level::Settings
+{
+  const auto map_path =
+    std::filesystem::path{ level }.replace_extension(".map.json");
+  const auto tileset = utils::read_json(assets_directory / base.tileset_name);
+  const auto tile_size = glm::uvec2(tileset.at("tilewidth").get<unsigned>(),
+                                    tileset.at("tileheight").get<unsigned>());
+
+  spdlog::info("LevelGenerator: generating {}x{} map '{}'",
+               settings.width,
+               settings.height,
+               map_path.c_str());
+  write_map(*generate(settings),
+            assets_directory / map_path,
+            std::filesystem::path{ base.tileset_name }.lexically_relative(
+              map_path.parent_path()),
+            tile_size);
+
+  base.tilemap_path = map_path.generic_string();
+  utils::write_json(assets_directory / level, base);
+  return base;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include <glm/glm.hpp>
+
+#include <bm/level.hpp>
+#include <render/tiled_map.hpp>
+
+namespace bm {
+
+/**
+ * @brief Generates synthetic levels of arbitrary size (e.g. for stress tests)
+ *
+ * The map consists of a layer of walls and hidden layers of crates and NPCs
+ * (see `GameController`). Walls are only placed on pillars (cells of odd x
+ * and y, as in Bomberman), so that all free cells stay connected. Cells around
+ * player's spawn are kept free. Layout only depends on settings (seed
+ * included).
+ */
+struct LevelGenerator
+{
+  /// @brief Tile indices (of level's default tileset)
+  static constexpr render::TiledMap::TileIndex floor_tile = 0;
+  static constexpr render::TiledMap::TileIndex wall_tile = 68;
+  /// @brief Tile of hidden layers (crates & NPCs)
+  static constexpr render::TiledMap::TileIndex marker_tile = 90;
+  /// @brief Free cells around spawn (Manhattan distance)
+  static constexpr int spawn_clearance = 2;
+
+  struct Settings
+  {
+    unsigned width{ 64 };
+    unsigned height{ 64 };
+    /// @brief Ratio of pillars, which are walls
+    float wall_density{ 1.0f };
+    /// @brief Ratio of free cells with a crate
+    float crate_density{ 0.3f };
+    /// @brief Ratio of free cells (without crate) with an NPC
+    float npc_density{ 0.01f };
+    std::uint32_t seed{ 5489 };
+  };
+
+  /// @brief Generate map (without tileset)
+  static auto generate(const Settings& settings)
+    -> std::shared_ptr<render::TiledMap>;
+
+  /**
+   * @brief Write map in Tiled's JSON format
+   *
+   * Layers are zlib compressed and base64 encoded, which keeps even maps of
+   * millions of tiles small and fast to load.
+   *
+   * @param tileset Map's tileset (relative to map's directory)
+   * @param tile_size Size of a tile in pixels
+   */
+  static auto write_map(const render::TiledMap& map,
+                        const std::filesystem::path& file,
+                        const std::filesystem::path& tileset,
+                        glm::uvec2 tile_size) -> void;
+
+  /**
+   * @brief Generate and write level's map & definition
+   *
+   * Map is written next to the definition (with .map.json extension).
+   *
+   * @param level Definition (JSON) to write, relative to assets
+   * @param base Tilesets of the level (its map is replaced)
+   * @return Definition of the level
+   */
+  static auto write_level(const Settings& settings,
+                          const std::filesystem::path& assets_directory,
+                          const std::filesystem::path& level,
+                          Level::Settings base) -> Level::Settings;
+};
+
+} // namespace bm
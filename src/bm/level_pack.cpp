@@ -0,0 +1,364 @@
+#include <bm/level_pack.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+#include <spdlog/spdlog.h>
+
+using namespace bm;
+
+namespace {
+class BinaryWriter
+{
+public:
+  template<typename T>
+  auto write(const T& value) -> void
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    write_bytes(&value, sizeof(T));
+  }
+
+  auto write(const std::string& value) -> void
+  {
+    write(static_cast<std::uint32_t>(value.size()));
+    write_bytes(value.data(), value.size());
+  }
+
+  template<typename T>
+  auto write(const std::vector<T>& values) -> void
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    write(static_cast<std::uint32_t>(values.size()));
+    write_bytes(values.data(), values.size() * sizeof(T));
+  }
+
+  auto write_bytes(const void* data, std::size_t size) -> void
+  {
+    const auto* bytes = static_cast<const std::byte*>(data);
+    data_.insert(data_.end(), bytes, bytes + size);
+  }
+
+  auto get_data() const -> const std::vector<std::byte>& { return data_; }
+
+private:
+  std::vector<std::byte> data_;
+};
+
+/// @brief Bounds-checked reading from a mapped pack
+class BinaryReader
+{
+public:
+  BinaryReader(const std::byte* data, std::size_t size)
+    : data_{ data }
+    , size_{ size }
+  {
+  }
+
+  template<typename T>
+  auto read() -> T
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value;
+    std::memcpy(&value, read_bytes(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  auto read_string() -> std::string
+  {
+    const auto length = read<std::uint32_t>();
+    const auto* data = reinterpret_cast<const char*>(read_bytes(length));
+    return std::string(data, length);
+  }
+
+  template<typename T>
+  auto read_vector() -> std::vector<T>
+  {
+    const auto count = read<std::uint32_t>();
+    const auto* data = read_bytes(count * sizeof(T));
+    std::vector<T> result(count);
+    std::memcpy(result.data(), data, count * sizeof(T));
+    return result;
+  }
+
+  /// @brief Reference `size` bytes in place (without copying)
+  auto read_bytes(std::size_t size) -> const std::byte*
+  {
+    if (size > size_ - offset_) {
+      throw std::runtime_error(
+        fmt::format("LevelPack: truncated at offset {}", offset_));
+    }
+    const auto* result = data_ + offset_;
+    offset_ += size;
+    return result;
+  }
+
+private:
+  const std::byte* data_;
+  std::size_t size_;
+  std::size_t offset_{ 0 };
+};
+
+auto
+hash_bytes(const void* data, std::size_t size) -> std::size_t
+{
+  return std::hash<std::string_view>{}(
+    { static_cast<const char*>(data), size });
+}
+
+struct AnimationKeypointRecord
+{
+  std::uint32_t duration_ms;
+  std::uint32_t tile;
+};
+} // namespace
+
+LevelPack::LevelPack(const std::filesystem::path& file)
+  : directory_{ file.parent_path() }
+  , mapping_{ std::make_shared<utils::MappedFile>(file) }
+  , settings_{}
+  , map_{ std::make_shared<render::TiledMap>() }
+{
+  BinaryReader reader{ mapping_->get_data(), mapping_->get_size() };
+  if (reader.read<std::uint32_t>() != magic or
+      reader.read<std::uint32_t>() != version) {
+    throw std::runtime_error(
+      fmt::format("LevelPack: '{}' is not a pack of version {}",
+                  file.c_str(),
+                  version));
+  }
+
+  // Sources
+  const auto source_count = reader.read<std::uint32_t>();
+  for (std::uint32_t i = 0; i < source_count; i++) {
+    Source source;
+    source.path_ = reader.read_string();
+    source.modification_time_ = reader.read<std::int64_t>();
+    source.size_ = reader.read<std::uint64_t>();
+    sources_.emplace_back(std::move(source));
+  }
+
+  // Settings
+  settings_.tileset_name = reader.read_string();
+  settings_.tilemap_path = reader.read_string();
+  const auto tileset_path_count = reader.read<std::uint32_t>();
+  for (std::uint32_t i = 0; i < tileset_path_count; i++) {
+    settings_.tilesets.emplace_back(reader.read_string());
+  }
+
+  // Map
+  map_->count_x = reader.read<std::uint32_t>();
+  map_->count_y = reader.read<std::uint32_t>();
+  const auto layer_count = reader.read<std::uint32_t>();
+  for (std::uint32_t i = 0; i < layer_count; i++) {
+    render::TiledMap::Layer layer;
+    layer.name_ = reader.read_string();
+    layer.visible_ = reader.read<std::uint8_t>() != 0;
+    if (reader.read<std::uint8_t>() != 0) {
+      layer.data_ = render::TiledMap::TileLayer{
+        reader.read_vector<render::TiledMap::TileIndex>()
+      };
+    } else {
+      layer.data_ = render::TiledMap::ObjectLayer{};
+    }
+    map_->layers_.emplace_back(std::move(layer));
+  }
+  map_->validate();
+
+  // Tilesets
+  const auto tileset_count = reader.read<std::uint32_t>();
+  for (std::uint32_t i = 0; i < tileset_count; i++) {
+    NamedTileset named;
+    named.name_ = reader.read_string();
+
+    auto tileset = std::make_shared<render::Tileset>();
+    tileset->tile_size_x_ = reader.read<std::uint32_t>();
+    tileset->tile_size_y_ = reader.read<std::uint32_t>();
+    tileset->total_tiles_ = reader.read<std::uint32_t>();
+    if (reader.read<std::uint8_t>() != 0) {
+      const auto rgba = reader.read<std::array<std::uint8_t, 4>>();
+      tileset->transparent_color_ =
+        utils::Color(rgba[0], rgba[1], rgba[2], rgba[3]);
+    }
+
+    const auto animation_count = reader.read<std::uint32_t>();
+    tileset->animations.resize(animation_count);
+    for (auto& animation : tileset->animations) {
+      for (const auto& keypoint :
+           reader.read_vector<AnimationKeypointRecord>()) {
+        animation.sequence.emplace_back(render::Tileset::Animation::Keypoint{
+          std::chrono::milliseconds{ keypoint.duration_ms }, keypoint.tile });
+      }
+    }
+
+    render::ImageData image;
+    image.width_ = reader.read<std::uint32_t>();
+    image.height_ = reader.read<std::uint32_t>();
+    image.format_ = static_cast<gl::GLenum>(reader.read<std::uint32_t>());
+    if (image.is_palettized()) {
+      image.palette_ = reinterpret_cast<const gl::GLubyte*>(
+        reader.read_bytes(render::ImageData::palette_size * 4));
+    }
+    image.pixels_ = reinterpret_cast<const gl::GLubyte*>(
+      reader.read_bytes(image.get_pixels_size()));
+    image.storage_ = mapping_;
+
+    // Pack images have no source path, they are identified by content only
+    // (so identical textures are shared among packs)
+    auto image_key = utils::ResourceKey{
+      fmt::format("pack:{}x{}:{}",
+                  image.width_,
+                  image.height_,
+                  static_cast<std::uint32_t>(image.format_)),
+      hash_bytes(image.pixels_, image.get_pixels_size())
+    };
+    if (image.is_palettized()) {
+      image_key.content_hash_ ^=
+        hash_bytes(image.palette_, render::ImageData::palette_size * 4) << 1;
+    }
+    named.tileset_ = render::Tileset::Decoded{
+      tileset, std::move(image), {}, std::nullopt, std::move(image_key)
+    };
+    tilesets_.emplace_back(std::move(named));
+  }
+}
+
+auto
+LevelPack::open_if_fresh(const std::filesystem::path& file)
+  -> std::shared_ptr<LevelPack>
+{
+  if (not std::filesystem::exists(file)) {
+    return nullptr;
+  }
+
+  try {
+    auto pack = std::make_shared<LevelPack>(file);
+    if (pack->is_stale()) {
+      spdlog::info("LevelPack: '{}' is stale, ignoring it", file.c_str());
+      return nullptr;
+    }
+    return pack;
+  } catch (const std::exception& e) {
+    spdlog::warn("LevelPack: ignoring '{}': {}", file.c_str(), e.what());
+    return nullptr;
+  }
+}
+
+auto
+LevelPack::is_stale() const -> bool
+{
+  for (const auto& source : sources_) {
+    const auto path = directory_ / source.path_;
+    if (not std::filesystem::exists(path)) {
+      return true;
+    }
+
+    const auto current = describe_source(path, directory_);
+    if (current.modification_time_ != source.modification_time_ or
+        current.size_ != source.size_) {
+      SPDLOG_DEBUG("LevelPack: source '{}' has changed", path.c_str());
+      return true;
+    }
+  }
+  return false;
+}
+
+auto
+LevelPack::describe_source(const std::filesystem::path& file,
+                           const std::filesystem::path& pack_directory)
+  -> Source
+{
+  Source source;
+  source.path_ = std::filesystem::relative(file, pack_directory);
+  source.modification_time_ = static_cast<std::int64_t>(
+    std::filesystem::last_write_time(file).time_since_epoch().count());
+  source.size_ = std::filesystem::file_size(file);
+  return source;
+}
+
+auto
+LevelPack::write(const std::filesystem::path& file,
+                 const std::vector<std::filesystem::path>& sources,
+                 const Level::Settings& settings,
+                 const render::TiledMap& map,
+                 const std::vector<NamedTileset>& tilesets) -> void
+{
+  BinaryWriter writer;
+  writer.write(magic);
+  writer.write(version);
+
+  writer.write(static_cast<std::uint32_t>(sources.size()));
+  for (const auto& source_file : sources) {
+    const auto source = describe_source(source_file, file.parent_path());
+    writer.write(source.path_.string());
+    writer.write(source.modification_time_);
+    writer.write(source.size_);
+  }
+
+  writer.write(settings.tileset_name);
+  writer.write(settings.tilemap_path);
+  writer.write(static_cast<std::uint32_t>(settings.tilesets.size()));
+  for (const auto& tileset_path : settings.tilesets) {
+    writer.write(tileset_path);
+  }
+
+  writer.write(static_cast<std::uint32_t>(map.count_x));
+  writer.write(static_cast<std::uint32_t>(map.count_y));
+  writer.write(static_cast<std::uint32_t>(map.layers_.size()));
+  for (const auto& layer : map.layers_) {
+    writer.write(layer.name_);
+    writer.write(static_cast<std::uint8_t>(layer.visible_));
+    const auto* tile_layer =
+      std::get_if<render::TiledMap::TileLayer>(&layer.data_);
+    writer.write(static_cast<std::uint8_t>(tile_layer != nullptr));
+    if (tile_layer) {
+      writer.write(tile_layer->tile_indices_);
+    }
+  }
+
+  writer.write(static_cast<std::uint32_t>(tilesets.size()));
+  for (const auto& [name, decoded] : tilesets) {
+    const auto& tileset = *decoded.tileset_;
+    writer.write(name);
+    writer.write(static_cast<std::uint32_t>(tileset.tile_size_x_));
+    writer.write(static_cast<std::uint32_t>(tileset.tile_size_y_));
+    writer.write(static_cast<std::uint32_t>(tileset.total_tiles_));
+    writer.write(static_cast<std::uint8_t>(tileset.transparent_color_ ? 1 : 0));
+    if (const auto& color = tileset.transparent_color_) {
+      writer.write(
+        std::array<std::uint8_t, 4>{ color->r, color->g, color->b, color->a });
+    }
+
+    writer.write(static_cast<std::uint32_t>(tileset.animations.size()));
+    for (const auto& animation : tileset.animations) {
+      std::vector<AnimationKeypointRecord> keypoints;
+      for (const auto& keypoint : animation.sequence) {
+        keypoints.push_back(AnimationKeypointRecord{
+          static_cast<std::uint32_t>(keypoint.duration.count()),
+          keypoint.tile });
+      }
+      writer.write(keypoints);
+    }
+
+    const auto& image = decoded.image_;
+    writer.write(static_cast<std::uint32_t>(image.width_));
+    writer.write(static_cast<std::uint32_t>(image.height_));
+    writer.write(static_cast<std::uint32_t>(image.format_));
+    if (image.is_palettized()) {
+      writer.write_bytes(image.palette_, render::ImageData::palette_size * 4);
+    }
+    writer.write_bytes(image.pixels_, image.get_pixels_size());
+  }
+
+  std::ofstream output(file, std::ios::binary | std::ios::trunc);
+  const auto& data = writer.get_data();
+  output.write(reinterpret_cast<const char*>(data.data()), data.size());
+  if (not output) {
+    throw std::runtime_error(
+      fmt::format("LevelPack: failed to write '{}'", file.c_str()));
+  }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <bm/level.hpp>
+#include <render/tiled_map.hpp>
+#include <render/tileset.hpp>
+#include <utils/mapped_file.hpp>
+
+namespace bm {
+
+/**
+ * @brief Level, cooked offline into a single binary file
+ *
+ * A pack contains level's settings, the map (raw tile index arrays) and all
+ * tilesets (texture pixels ready for upload, animation tables). It is read
+ * via memory mapping: textures are uploaded straight from the mapping.
+ * Images with few colors are stored palettized (see `render::ImageData`).
+ *
+ * The pack records the files it has been cooked from (with their mtime and
+ * size). When any of them changes, the pack is stale and the level should be
+ * loaded from JSON instead.
+ *
+ * Layout (native byte order):
+ *  - header: magic, version
+ *  - sources: count, [path, mtime, size]...
+ *  - settings: tileset_name, tilemap_path, count, [tileset]...
+ *  - map: count_x, count_y, count, [name, visible, is_tile_layer, indices]...
+ *  - tilesets: count, [name, tile counts, color key, animations, image]...
+ *  - image: width, height, format, [palette], pixels
+ * Strings and arrays are prefixed by their 32-bit length.
+ */
+class LevelPack
+{
+public:
+  static constexpr std::uint32_t magic = 0x4B504D42; // "BMPK"
+  static constexpr std::uint32_t version = 2;
+
+  /// @brief File, the pack has been cooked from
+  struct Source
+  {
+    /// @brief Path, relative to pack's directory
+    std::filesystem::path path_;
+    std::int64_t modification_time_{ 0 };
+    std::uint64_t size_{ 0 };
+  };
+
+  struct NamedTileset
+  {
+    std::string name_;
+    render::Tileset::Decoded tileset_;
+  };
+
+  /// @brief Map & parse pack (throws on invalid file)
+  explicit LevelPack(const std::filesystem::path& file);
+
+  /// @brief Open pack if it exists and is up-to-date (nullptr otherwise)
+  static auto open_if_fresh(const std::filesystem::path& file)
+    -> std::shared_ptr<LevelPack>;
+
+  auto is_stale() const -> bool;
+
+  auto get_settings() const -> const Level::Settings& { return settings_; }
+  auto get_map() const -> const std::shared_ptr<render::TiledMap>&
+  {
+    return map_;
+  }
+  /// @brief Tilesets (images reference the mapping & keep it alive)
+  auto get_tilesets() const -> const std::vector<NamedTileset>&
+  {
+    return tilesets_;
+  }
+
+  /// @brief Cook pack (the first tileset is level's "default")
+  static auto write(const std::filesystem::path& file,
+                    const std::vector<std::filesystem::path>& sources,
+                    const Level::Settings& settings,
+                    const render::TiledMap& map,
+                    const std::vector<NamedTileset>& tilesets) -> void;
+
+  /// @brief Describe `file` for staleness checks
+  static auto describe_source(const std::filesystem::path& file,
+                              const std::filesystem::path& pack_directory)
+    -> Source;
+
+private:
+  std::filesystem::path directory_;
+  std::shared_ptr<utils::MappedFile> mapping_;
+
+  std::vector<Source> sources_;
+  Level::Settings settings_;
+  std::shared_ptr<render::TiledMap> map_;
+  std::vector<NamedTileset> tilesets_;
+};
+
+} // namespace bm
@@ -1,4 +1,5 @@
 #include <bm/navigation_mesh.hpp>
+#include <chrono>
 #include <unordered_set>
 #include <utils/graph_algorithms.hpp>
 #include <utils/occupancy_map.hpp>
@@ -69,6 +70,7 @@ auto
 NavigationMesh::compute_path(glm::vec2 start, glm::vec2 end)
   -> std::vector<glm::vec2>
 {
+  const auto start_time = std::chrono::steady_clock::now();
   auto node_id_paths = utils::graph_algorithms::compute_shortest_path(
     cache_.graph, compute_node_id(start), compute_node_id(end));
 
@@ -79,6 +81,9 @@ NavigationMesh::compute_path(glm::vec2 start, glm::vec2 end)
                  [this](const auto node_id) {
                    return compute_position_from_node_id(node_id);
                  });
+
+  path_queries_.increment();
+  path_query_latency_.record(std::chrono::steady_clock::now() - start_time);
   return result;
 }
 
@@ -3,6 +3,7 @@
 #include <bm/world.hpp>
 #include <utils/aabb.hpp>
 #include <utils/graph.hpp>
+#include <utils/metrics.hpp>
 
 namespace bm {
 
@@ -33,5 +34,10 @@ private:
   } cache_;
 
   bm::interfaces::ICollisionWorld& world_;
+
+  utils::Counter path_queries_{ "navigation_path_queries_total" };
+  utils::Histogram path_query_latency_{
+    "navigation_path_query_latency_nanoseconds"
+  };
 };
 } // namespace bm
\ No newline at end of file
@@ -37,7 +37,7 @@ NPCController::update() -> void
     }
     npc_data.ticks_to_change = 10;
 */
-    spdlog::trace("update(): entity '{}'", id);
+    SPDLOG_TRACE("update(): entity '{}'", id);
 
     using namespace bm::game_logic;
     switch (npc_data.goal) {
@@ -52,6 +52,12 @@ NPCController::update() -> void
   }
 }
 
+auto
+NPCController::seed(std::uint32_t seed) -> void
+{
+  generator.seed(seed);
+}
+
 auto
 NPCController::update_random_movement(bm::Entity& entity) -> void
 {
@@ -13,6 +13,8 @@ public:
   NPCController(EventDistributor& event_distributor, bm::World& world);
 
   auto update() -> void;
+  /// @brief Restart random generator (e.g. for reproducible matches)
+  auto seed(std::uint32_t seed) -> void;
 
 private:
   auto update_random_movement(bm::Entity& entity) -> void;
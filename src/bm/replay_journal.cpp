@@ -0,0 +1,160 @@
+#include <bm/replay_journal.hpp>
+
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fmt/format.h>
+
+using namespace bm;
+
+namespace {
+/// @brief Type of entry, terminating the journal
+constexpr std::uint8_t end_type = 0xFF;
+
+template<typename T>
+auto
+write(std::ofstream& output, const T& value) -> void
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/// @brief Bounds-checked reading of a journal
+class JournalReader
+{
+public:
+  explicit JournalReader(std::vector<char> data)
+    : data_{ std::move(data) }
+  {
+  }
+
+  template<typename T>
+  auto read() -> T
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (sizeof(T) > data_.size() - offset_) {
+      throw std::runtime_error(
+        fmt::format("ReplayJournal: truncated at offset {}", offset_));
+    }
+    T value;
+    std::memcpy(&value, data_.data() + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return value;
+  }
+
+  auto is_at_end() const -> bool { return offset_ == data_.size(); }
+
+private:
+  std::vector<char> data_;
+  std::size_t offset_{ 0 };
+};
+} // namespace
+
+ReplayJournal::Writer::Writer(const std::filesystem::path& file,
+                              std::uint32_t seed,
+                              std::uint32_t tick_duration_ms)
+  : file_{ file }
+  , output_{ file, std::ios::binary | std::ios::trunc }
+{
+  write(output_, magic);
+  write(output_, version);
+  write(output_, seed);
+  write(output_, tick_duration_ms);
+  if (not output_) {
+    throw std::runtime_error(
+      fmt::format("ReplayJournal: failed to write '{}'", file_.c_str()));
+  }
+}
+
+auto
+ReplayJournal::Writer::append(const Entry& entry) -> void
+{
+  write(output_, entry.tick_);
+  write(output_, static_cast<std::uint8_t>(entry.input_.index()));
+  std::visit(
+    [this](const auto& input) {
+      using T = std::decay_t<decltype(input)>;
+      if constexpr (std::is_same_v<T, event::PlayerMoved>) {
+        write(output_, static_cast<std::uint32_t>(input.actor_));
+        write(output_, static_cast<std::uint8_t>(input.should_accelerate));
+        write(output_, static_cast<std::uint8_t>(input.direction_));
+      } else if constexpr (std::is_same_v<T, event::PlayerActionEvent>) {
+        write(output_, static_cast<std::uint32_t>(input.actor_));
+      }
+    },
+    entry.input_);
+}
+
+auto
+ReplayJournal::Writer::finish(std::uint32_t tick, std::uint64_t state_hash)
+  -> void
+{
+  write(output_, tick);
+  write(output_, end_type);
+  write(output_, state_hash);
+  output_.flush();
+  if (not output_) {
+    throw std::runtime_error(
+      fmt::format("ReplayJournal: failed to write '{}'", file_.c_str()));
+  }
+}
+
+auto
+ReplayJournal::read(const std::filesystem::path& file) -> ReplayJournal
+{
+  std::ifstream input(file, std::ios::binary);
+  if (not input) {
+    throw std::runtime_error(
+      fmt::format("ReplayJournal: failed to open '{}'", file.c_str()));
+  }
+  JournalReader reader{ std::vector<char>(std::istreambuf_iterator<char>(input),
+                                          std::istreambuf_iterator<char>()) };
+
+  if (reader.read<std::uint32_t>() != magic) {
+    throw std::runtime_error(
+      fmt::format("ReplayJournal: '{}' is not a journal", file.c_str()));
+  }
+  if (const auto file_version = reader.read<std::uint32_t>();
+      file_version != version) {
+    throw std::runtime_error(
+      fmt::format("ReplayJournal: '{}' has version {} (expected {})",
+                  file.c_str(),
+                  file_version,
+                  version));
+  }
+
+  ReplayJournal journal;
+  journal.seed_ = reader.read<std::uint32_t>();
+  journal.tick_duration_ms_ = reader.read<std::uint32_t>();
+  while (not reader.is_at_end()) {
+    const auto tick = reader.read<std::uint32_t>();
+    switch (const auto type = reader.read<std::uint8_t>()) {
+      case 0:
+        journal.entries_.push_back(Entry{ tick, event::GameStarted{} });
+        break;
+      case 1: {
+        event::PlayerMoved moved;
+        moved.actor_ = reader.read<std::uint32_t>();
+        moved.should_accelerate = reader.read<std::uint8_t>() != 0;
+        moved.direction_ = static_cast<event::PlayerMoved::MoveDirection>(
+          reader.read<std::uint8_t>());
+        journal.entries_.push_back(Entry{ tick, moved });
+      } break;
+      case 2: {
+        event::PlayerActionEvent action;
+        action.actor_ = reader.read<std::uint32_t>();
+        journal.entries_.push_back(Entry{ tick, action });
+      } break;
+      case end_type:
+        journal.final_tick_ = tick;
+        journal.final_state_hash_ = reader.read<std::uint64_t>();
+        return journal;
+      default:
+        throw std::runtime_error(fmt::format(
+          "ReplayJournal: unknown entry type {} in '{}'", type, file.c_str()));
+    }
+  }
+  return journal;
+}
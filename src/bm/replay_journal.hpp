@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <variant>
+#include <vector>
+
+#include <bm/events.hpp>
+
+namespace bm {
+
+/**
+ * @brief Player's inputs of a session, which can be replayed
+ *
+ * The simulation is deterministic given its random seed and the inputs, fed
+ * at the same ticks (see `Simulation`). The journal records just these, plus
+ * the state (hash) reached at the end, to verify the replay.
+ *
+ * Layout (native byte order):
+ *  - header: magic, version, seed, tick duration (ms)
+ *  - entries: tick, type, payload...
+ *  - end: tick, type (end), state hash
+ * Ticks are counted from (re)start of the match.
+ */
+struct ReplayJournal
+{
+  static constexpr std::uint32_t magic = 0x4A524D42; // "BMRJ"
+  static constexpr std::uint32_t version = 1;
+
+  /// @brief Input (restarts included, as `GameStarted`)
+  using Input = std::variant<event::GameStarted,
+                             event::PlayerMoved,
+                             event::PlayerActionEvent>;
+
+  struct Entry
+  {
+    std::uint32_t tick_;
+    Input input_;
+  };
+
+  /// @brief Streams entries to file as they come
+  class Writer
+  {
+  public:
+    Writer(const std::filesystem::path& file,
+           std::uint32_t seed,
+           std::uint32_t tick_duration_ms);
+
+    auto append(const Entry& entry) -> void;
+    /// @brief Terminate journal by the final state
+    auto finish(std::uint32_t tick, std::uint64_t state_hash) -> void;
+
+  private:
+    std::filesystem::path file_;
+    std::ofstream output_;
+  };
+
+  /// @brief Read journal (throws on invalid file)
+  /// @note Journal without end (e.g. of a crashed session) is accepted
+  static auto read(const std::filesystem::path& file) -> ReplayJournal;
+
+  std::uint32_t seed_{ 0 };
+  std::uint32_t tick_duration_ms_{ 0 };
+  std::vector<Entry> entries_;
+  /// @brief Tick & state at the end of recording
+  std::optional<std::uint32_t> final_tick_;
+  std::optional<std::uint64_t> final_state_hash_;
+};
+
+} // namespace bm
@@ -0,0 +1,275 @@
+#include <bm/simulation.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <spdlog/spdlog.h>
+#include <utils/profiler.hpp>
+
+using namespace bm;
+
+namespace {
+/// @brief FNV-1a (stable across runs and platforms of the same endianness)
+class StateHasher
+{
+public:
+  template<typename T>
+  auto add(const T& value) -> StateHasher&
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (const auto byte : bytes) {
+      hash_ = (hash_ ^ byte) * 0x100000001B3ull;
+    }
+    return *this;
+  }
+
+  auto get() const -> std::uint64_t { return hash_; }
+
+private:
+  std::uint64_t hash_{ 0xCBF29CE484222325ull };
+};
+} // namespace
+
+Simulation::Simulation(interfaces::IGame& game,
+                       GameController::Texts& texts,
+                       Settings settings)
+  : event_distributor_{}
+  , world_{ event_distributor_ }
+  , settings_{ std::move(settings) }
+  , game_controller_{ game, event_distributor_, texts, world_ }
+  , npc_controller_{ event_distributor_, world_ }
+{
+  if (not settings_.journal.empty() and not settings_.fixed_timestep) {
+    throw std::runtime_error(
+      "Simulation: recording a journal requires fixed timestep");
+  }
+}
+
+Simulation::~Simulation()
+{
+  if (not journal_) {
+    return;
+  }
+  try {
+    journal_->finish(tick_, compute_state_hash());
+    spdlog::info("Simulation: journal of {} ticks written to '{}'",
+                 tick_,
+                 settings_.journal.c_str());
+  } catch (const std::exception& e) {
+    spdlog::error("Simulation: failed to finish journal: {}", e.what());
+  }
+}
+
+auto
+Simulation::start() -> void
+{
+  SPDLOG_DEBUG("Simulation::start()");
+  if (not journal_ and not settings_.journal.empty()) {
+    journal_ = std::make_unique<ReplayJournal::Writer>(
+      settings_.journal,
+      settings_.seed,
+      static_cast<std::uint32_t>(tick_duration.count()));
+  }
+
+  tick_ = 0;
+  accumulated_ = std::chrono::microseconds{ 0 };
+  if (settings_.fixed_timestep) {
+    event_distributor_.set_simulated_time(EventDistributor::Timestamp{});
+    game_controller_.seed(settings_.seed);
+    npc_controller_.seed(settings_.seed);
+  }
+
+  world_.clear();
+  event_distributor_.clear();
+  event_distributor_.enqueue_event(event::GameStarted{});
+}
+
+auto
+Simulation::submit(const ReplayJournal::Input& input) -> void
+{
+  if (journal_) {
+    journal_->append(ReplayJournal::Entry{ tick_, input });
+  }
+  apply(input);
+}
+
+auto
+Simulation::apply(const ReplayJournal::Input& input) -> void
+{
+  std::visit(
+    [this](const auto& event) {
+      using T = std::decay_t<decltype(event)>;
+      if constexpr (std::is_same_v<T, event::GameStarted>) {
+        start();
+      } else {
+        event_distributor_.enqueue_event(event);
+      }
+    },
+    input);
+}
+
+auto
+Simulation::update(std::chrono::microseconds delta) -> void
+{
+  if (not settings_.fixed_timestep) {
+    step(delta);
+    return;
+  }
+
+  accumulated_ += delta;
+  for (unsigned i = 0; accumulated_ >= tick_duration; i++) {
+    if (i == max_ticks_per_update) {
+      SPDLOG_DEBUG("Simulation: dropping {} us", accumulated_.count());
+      accumulated_ = std::chrono::microseconds{ 0 };
+      break;
+    }
+    accumulated_ -= tick_duration;
+    tick();
+  }
+}
+
+auto
+Simulation::tick() -> void
+{
+  // Inputs, submitted after this tick, are planned at its time as well
+  event_distributor_.set_simulated_time(EventDistributor::Timestamp{} +
+                                        tick_ * tick_duration);
+  step(tick_duration);
+  tick_++;
+}
+
+auto
+Simulation::step(std::chrono::microseconds delta) -> void
+{
+  {
+    PROFILE_ZONE("dispatch events");
+    event_distributor_.dispatch();
+  }
+  {
+    PROFILE_ZONE("world update");
+    world_.update(delta);
+  }
+  {
+    PROFILE_ZONE("delete entities");
+    world_.delete_marked_entities();
+  }
+  {
+    PROFILE_ZONE("npc update");
+    npc_controller_.update();
+  }
+}
+
+auto
+Simulation::replay(const ReplayJournal& journal,
+                   const std::function<void()>& on_tick) -> std::uint64_t
+{
+  if (not settings_.fixed_timestep or
+      journal.tick_duration_ms_ != tick_duration.count()) {
+    throw std::runtime_error(
+      fmt::format("Simulation: can't replay journal of {} ms ticks",
+                  journal.tick_duration_ms_));
+  }
+
+  const auto replay_tick = [&]() {
+    tick();
+    if (on_tick) {
+      on_tick();
+    }
+  };
+
+  settings_.seed = journal.seed_;
+  start();
+  for (const auto& entry : journal.entries_) {
+    while (tick_ < entry.tick_) {
+      replay_tick();
+    }
+    apply(entry.input_);
+  }
+  if (journal.final_tick_) {
+    while (tick_ < *journal.final_tick_) {
+      replay_tick();
+    }
+  }
+  return compute_state_hash();
+}
+
+auto
+Simulation::load_static_collisions(const render::TiledMap& map) -> void
+{
+  world_.update_boundary(glm::vec2(0, 0), glm::vec2(map.count_x, map.count_y));
+
+  utils::OccupancyMap2D<bool> static_collision_map{
+    { map.count_x, map.count_y }, false
+  };
+
+  const auto& tile_map =
+    std::get<render::TiledMap::TileLayer>(map.layers_.at(0).data_);
+
+  std::transform(tile_map.tile_indices_.begin(),
+                 tile_map.tile_indices_.end(),
+                 static_collision_map.begin(),
+                 [](auto tile_id) { return (tile_id != 0); });
+
+  world_.update_static_collisions(std::move(static_collision_map));
+}
+
+auto
+Simulation::compute_state_hash() -> std::uint64_t
+{
+  // Entities are hashed in order of IDs (not of world's hash map)
+  std::vector<const Entity*> entities;
+  for (const auto& [id, entity] : world_) {
+    entities.push_back(&entity);
+  }
+  std::sort(entities.begin(), entities.end(), [](auto a, auto b) {
+    return a->id_ < b->id_;
+  });
+
+  StateHasher hasher;
+  for (const auto* entity : entities) {
+    hasher.add(entity->id_)
+      .add(entity->type_)
+      .add(entity->flags_.to_ulong())
+      .add(entity->aabb_.origin_)
+      .add(entity->aabb_.size_)
+      .add(entity->collision_mask_.to_ulong())
+      .add(entity->max_speed_)
+      .add(entity->velocity_)
+      .add(entity->acceleration_);
+
+    const auto& controller = entity->controller_;
+    hasher.add(controller.moving_left)
+      .add(controller.moving_right)
+      .add(controller.moving_down)
+      .add(controller.moving_up)
+      .add(controller.animation_next_position.value_or(glm::vec2{ -1 }));
+
+    hasher.add(entity->data_.index());
+    std::visit(
+      [&hasher](const auto& data) {
+        using T = std::decay_t<decltype(data)>;
+        using namespace game_logic;
+        if constexpr (std::is_same_v<T, PlayerData>) {
+          hasher.add(data.weapon_)
+            .add(data.bomb_prototype_.range_)
+            .add(data.available_bomb_count_);
+        } else if constexpr (std::is_same_v<T, PickupData>) {
+          hasher.add(data.type_);
+        } else if constexpr (std::is_same_v<T, BombData>) {
+          hasher.add(data.parent_entity_id_.value_or(~0u))
+            .add(data.prototype_.range_);
+        } else if constexpr (std::is_same_v<T, NPCData>) {
+          hasher.add(data.goal).add(data.target_id);
+          for (const auto& point : data.trajectory) {
+            hasher.add(point);
+          }
+        }
+      },
+      entity->data_);
+  }
+  return hasher.get();
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+
+#include <bm/event_distributor.hpp>
+#include <bm/game_controller.hpp>
+#include <bm/npc_controller.hpp>
+#include <bm/replay_journal.hpp>
+#include <bm/world.hpp>
+#include <render/tiled_map.hpp>
+
+namespace bm {
+
+/**
+ * @brief Game logic (world, events & controllers) without rendering
+ *
+ * By default, the simulation follows wall-clock: an update advances it by
+ * frame's delta. With a fixed timestep, it advances by whole ticks instead,
+ * events are planned in simulated time and random generators are seeded at
+ * each (re)start of the match. Then the match only depends on the seed and
+ * inputs (and the ticks they came at), so it can be recorded into a
+ * `ReplayJournal` and replayed (e.g. headless, as fast as possible).
+ */
+class Simulation
+{
+public:
+  static constexpr std::chrono::milliseconds tick_duration{ 16 };
+  /// @brief Ticks of a single update at most (slower frames drop time)
+  static constexpr unsigned max_ticks_per_update = 8;
+  static constexpr std::uint32_t default_seed = 5489;
+
+  struct Settings
+  {
+    bool fixed_timestep{ false };
+    std::uint32_t seed{ default_seed };
+    /// @brief Record inputs there (requires fixed timestep)
+    std::filesystem::path journal;
+  };
+
+  Simulation(interfaces::IGame& game,
+             GameController::Texts& texts,
+             Settings settings);
+  /// @brief Finishes the journal (when recording)
+  ~Simulation();
+
+  /// @brief (Re)start the match
+  auto start() -> void;
+  /// @brief Apply player's input (recorded, when recording)
+  auto submit(const ReplayJournal::Input& input) -> void;
+
+  /// @brief Advance by frame's delta (or by ticks, it amounts to)
+  auto update(std::chrono::microseconds delta) -> void;
+  /// @brief Advance by a single tick (fixed timestep only)
+  auto tick() -> void;
+  /// @brief Ticks since (re)start of the match
+  auto get_tick() const -> std::uint32_t { return tick_; }
+
+  /// @brief Run journal's match to its end (as fast as possible)
+  /// @param on_tick Called after each tick (e.g. to measure it)
+  /// @return Hash of the final state (see `compute_state_hash()`)
+  auto replay(const ReplayJournal& journal,
+              const std::function<void()>& on_tick = {}) -> std::uint64_t;
+
+  /// @brief World's boundary & static collisions by map's first layer
+  auto load_static_collisions(const render::TiledMap& map) -> void;
+
+  /// @brief Hash of game state (entities' logic, not their visuals)
+  auto compute_state_hash() -> std::uint64_t;
+
+public:
+  EventDistributor event_distributor_;
+  /// @brief Pool of dynamic entities
+  World world_;
+
+private:
+  auto step(std::chrono::microseconds delta) -> void;
+  auto apply(const ReplayJournal::Input& input) -> void;
+
+  Settings settings_;
+
+  /// @brief Manages game dynamics (update of entites & map)
+  GameController game_controller_;
+  /// @brief Manages NPC's logic
+  NPCController npc_controller_;
+
+  std::uint32_t tick_{ 0 };
+  /// @brief Time not simulated yet (less than a tick)
+  std::chrono::microseconds accumulated_{ 0 };
+
+  /// @brief Inputs are recorded once the match starts
+  std::unique_ptr<ReplayJournal::Writer> journal_;
+};
+
+} // namespace bm
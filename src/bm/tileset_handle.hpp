@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <utils/string_interner.hpp>
+
+namespace bm {
+
+/**
+ * @brief Interned name of a tileset
+ *
+ * Handles are cheap to copy and compare, and index `TilesetRegistry`
+ * directly (instead of hashing the name on each lookup). Default handle
+ * names the "default" tileset.
+ */
+class TilesetHandle
+{
+public:
+  using Index = utils::StringInterner::Index;
+
+  TilesetHandle() = default;
+  explicit TilesetHandle(std::string_view name)
+    : index_{ get_interner().intern(name) }
+  {
+  }
+
+  auto get_index() const -> Index { return index_; }
+  auto get_name() const -> const std::string&
+  {
+    return get_interner().get_string(index_);
+  }
+  auto is_default() const -> bool { return index_ == 0; }
+
+  auto operator==(const TilesetHandle& other) const -> bool
+  {
+    return index_ == other.index_;
+  }
+  auto operator!=(const TilesetHandle& other) const -> bool
+  {
+    return index_ != other.index_;
+  }
+
+private:
+  static auto get_interner() -> utils::StringInterner&
+  {
+    static utils::StringInterner interner{ "default" };
+    return interner;
+  }
+
+  Index index_{ 0 };
+};
+
+} // namespace bm
@@ -0,0 +1,181 @@
+#include <bm/tileset_registry.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+#include <spdlog/spdlog.h>
+
+using namespace bm;
+
+TilesetRegistry::TilesetRegistry(std::size_t memory_budget)
+  : memory_budget_{ memory_budget }
+{
+}
+
+auto
+TilesetRegistry::set_load_function(LoadFunction load) -> void
+{
+  load_ = std::move(load);
+}
+
+auto
+TilesetRegistry::insert(TilesetHandle handle,
+                        TilesetPointer tileset,
+                        bool is_pinned) -> void
+{
+  auto& entry = get_entry(handle);
+  if (entry.tileset_) {
+    memory_usage_ -= entry.tileset_->texture_size_;
+  }
+  memory_usage_ += tileset->texture_size_;
+
+  entry.tileset_ = std::move(tileset);
+  entry.is_pinned_ = entry.is_pinned_ or is_pinned;
+  entry.has_failed_ = false;
+  entry.last_used_frame_ = frame_;
+}
+
+auto
+TilesetRegistry::acquire(TilesetHandle handle) -> render::Tileset*
+{
+  auto& entry = get_entry(handle);
+  entry.last_used_frame_ = frame_;
+  if (entry.tileset_) {
+    return entry.tileset_.get();
+  }
+
+  if (not entry.pending_.valid() and not entry.has_failed_) {
+    if (load_) {
+      SPDLOG_DEBUG("TilesetRegistry: loading '{}' on demand",
+                   handle.get_name());
+      entry.pending_ = load_(handle.get_name());
+    } else {
+      spdlog::warn("TilesetRegistry: '{}' is not loaded, using '{}'",
+                   handle.get_name(),
+                   fallback_name);
+      entry.has_failed_ = true;
+    }
+  }
+  const auto fallback = TilesetHandle{}.get_index();
+  return fallback < entries_.size() ? entries_[fallback].tileset_.get()
+                                    : nullptr;
+}
+
+auto
+TilesetRegistry::find(TilesetHandle handle) const -> TilesetPointer
+{
+  const auto index = handle.get_index();
+  return index < entries_.size() ? entries_[index].tileset_ : nullptr;
+}
+
+auto
+TilesetRegistry::get(TilesetHandle handle) const -> const render::Tileset*
+{
+  const auto index = handle.get_index();
+  return index < entries_.size() ? entries_[index].tileset_.get() : nullptr;
+}
+
+auto
+TilesetRegistry::update() -> void
+{
+  for (auto& entry : entries_) {
+    if (not entry.pending_.valid() or
+        entry.pending_.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready) {
+      continue;
+    }
+
+    if (entry.tileset_) {
+      // Inserted while loading (e.g. reloaded), pending result is stale
+      entry.pending_ = {};
+      continue;
+    }
+
+    try {
+      auto tileset = entry.pending_.get().upload();
+      memory_usage_ += tileset->texture_size_;
+      entry.tileset_ = std::move(tileset);
+    } catch (const std::exception& e) {
+      spdlog::error("TilesetRegistry: failed to load '{}', using '{}': {}",
+                    entry.handle_.get_name(),
+                    fallback_name,
+                    e.what());
+      entry.has_failed_ = true;
+    }
+  }
+
+  evict_over_budget();
+  frame_++;
+}
+
+auto
+TilesetRegistry::get_resident() const -> std::vector<TilesetHandle>
+{
+  std::vector<TilesetHandle> result;
+  for (const auto& entry : entries_) {
+    if (entry.tileset_) {
+      result.push_back(entry.handle_);
+    }
+  }
+  return result;
+}
+
+auto
+TilesetRegistry::get_memory_usage() const -> std::size_t
+{
+  return memory_usage_;
+}
+
+auto
+TilesetRegistry::set_memory_budget(std::size_t memory_budget) -> void
+{
+  memory_budget_ = memory_budget;
+}
+
+auto
+TilesetRegistry::get_entry(TilesetHandle handle) -> Entry&
+{
+  const auto index = handle.get_index();
+  if (index >= entries_.size()) {
+    entries_.resize(index + 1);
+  }
+  auto& entry = entries_[index];
+  entry.handle_ = handle;
+  return entry;
+}
+
+auto
+TilesetRegistry::evict_over_budget() -> void
+{
+  if (memory_usage_ <= memory_budget_) {
+    return;
+  }
+
+  // Candidates: resident, not pinned and not drawn in the current frame
+  std::vector<std::pair<std::uint64_t, Entry*>> candidates;
+  for (auto& entry : entries_) {
+    if (entry.tileset_ and not entry.is_pinned_ and
+        entry.last_used_frame_ < frame_) {
+      candidates.emplace_back(entry.last_used_frame_, &entry);
+    }
+  }
+  std::sort(candidates.begin(),
+            candidates.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  for (auto& [last_used_frame, entry] : candidates) {
+    if (memory_usage_ <= memory_budget_) {
+      break;
+    }
+    memory_usage_ -= entry->tileset_->texture_size_;
+    // Texture is released once no other level shares it
+    entry->tileset_.reset();
+  }
+
+  if (memory_usage_ > memory_budget_) {
+    SPDLOG_DEBUG("TilesetRegistry: {} bytes of visible tilesets exceed "
+                 "budget of {} bytes",
+                 memory_usage_,
+                 memory_budget_);
+  }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <bm/tileset_handle.hpp>
+#include <render/tileset.hpp>
+
+namespace bm {
+
+/**
+ * @brief Tilesets of a level, made resident on demand
+ *
+ * A tileset is loaded asynchronously when it is acquired for the first time.
+ * Until it is resident, `acquire()` returns the fallback ("default") tileset
+ * instead. Once textures of resident tilesets exceed the memory budget,
+ * tilesets that have not been acquired recently are evicted (least recently
+ * used first). Tilesets acquired during the last frame are never evicted.
+ *
+ * Tilesets are indexed by `TilesetHandle`, lookups are plain array accesses.
+ */
+class TilesetRegistry
+{
+public:
+  using TilesetPointer = std::shared_ptr<render::Tileset>;
+  /// @brief Starts loading of tileset `name` (e.g. on a thread pool)
+  using LoadFunction =
+    std::function<std::future<render::Tileset::Decoded>(const std::string&)>;
+
+  static constexpr auto fallback_name = "default";
+  static constexpr std::size_t default_memory_budget = 64 * 1024 * 1024;
+
+  explicit TilesetRegistry(std::size_t memory_budget = default_memory_budget);
+
+  /// @brief Set, how missing tilesets are loaded (none are loaded without)
+  auto set_load_function(LoadFunction load) -> void;
+
+  /// @brief Make tileset resident (pinned tilesets are never evicted)
+  auto insert(TilesetHandle handle, TilesetPointer tileset, bool is_pinned)
+    -> void;
+
+  /**
+   * @brief Tileset to be used for drawing in this frame
+   *
+   * @return Resident tileset, or the fallback one (nullptr when missing)
+   * while it loads. The pointer is valid until the next `update()` (which
+   * may evict the tileset).
+   */
+  auto acquire(TilesetHandle handle) -> render::Tileset*;
+
+  /// @brief Resident tileset (without loading it), or nullptr
+  auto find(TilesetHandle handle) const -> TilesetPointer;
+
+  /**
+   * @brief Resident tileset (without loading it), or nullptr
+   *
+   * Unlike `find()`, no reference is taken (for per-entity lookups). The
+   * pointer is valid until the next `update()`.
+   */
+  auto get(TilesetHandle handle) const -> const render::Tileset*;
+
+  /// @brief Make finished loads resident & evict over budget (on GL thread)
+  /// @note Expected to be called once per frame
+  auto update() -> void;
+
+  auto get_resident() const -> std::vector<TilesetHandle>;
+  /// @brief Estimated texture memory of resident tilesets (in bytes)
+  auto get_memory_usage() const -> std::size_t;
+  auto get_memory_budget() const -> std::size_t { return memory_budget_; }
+  auto set_memory_budget(std::size_t memory_budget) -> void;
+
+private:
+  struct Entry
+  {
+    TilesetHandle handle_;
+    TilesetPointer tileset_;
+    std::future<render::Tileset::Decoded> pending_;
+    std::uint64_t last_used_frame_{ 0 };
+    bool is_pinned_{ false };
+    /// @brief Loading failed (fallback is used from now on)
+    bool has_failed_{ false };
+  };
+
+  auto get_entry(TilesetHandle handle) -> Entry&;
+  auto evict_over_budget() -> void;
+
+  /// @brief Entries, indexed by handle
+  std::vector<Entry> entries_;
+  LoadFunction load_;
+  std::size_t memory_budget_;
+  std::size_t memory_usage_{ 0 };
+  std::uint64_t frame_{ 1 };
+};
+
+} // namespace bm
@@ -59,9 +59,10 @@ World::delete_marked_entities() -> void
 }
 
 auto
-World::update(std::chrono::milliseconds delta) -> void
+World::update(std::chrono::microseconds delta) -> void
 {
-  const auto elapsed_seconds = delta.count() / 1000.0f;
+  entities_gauge_.set(static_cast<std::int64_t>(entities_.size()));
+  const auto elapsed_seconds = delta.count() / 1e6f;
 
   /* Update acceleration and speed */
   for (auto& [id, entity] : entities_) {
@@ -156,14 +157,16 @@ World::update(std::chrono::milliseconds delta) -> void
       entity.aabb_.put_inside(boundary_);
     }
 
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
     if (glm::length(position_delta) > 0.01) {
-      spdlog::trace("Updated entity {} to position ({},{}) (delta: {},{})",
-                    id,
-                    entity.aabb_.origin_.x,
-                    entity.aabb_.origin_.y,
-                    position_delta.x,
-                    position_delta.y);
+      SPDLOG_TRACE("Updated entity {} to position ({},{}) (delta: {},{})",
+                   id,
+                   entity.aabb_.origin_.x,
+                   entity.aabb_.origin_.y,
+                   position_delta.x,
+                   position_delta.y);
     }
+#endif
   }
 
   /* Decrease speed (attenuation) */
@@ -229,6 +232,14 @@ World::update_static_collisions(utils::OccupancyMap2D<bool> map) -> void
   static_collisions_ = std::move(map);
 }
 
+auto
+World::set_static_collision(glm::uvec2 cell, bool is_colliding) -> void
+{
+  const auto offset = static_collisions_.transform_index_to_offset(
+    { cell.x, cell.y });
+  *(static_collisions_.begin() + offset) = is_colliding;
+}
+
 auto
 World::get_world_boundaries() -> utils::AABB
 {
@@ -317,7 +328,7 @@ World::detect_collisions() -> void
       const auto& b = entity_b.aabb_;
 
       if (a.collide(b)) {
-        spdlog::debug("Entity {} and {} collide", id_a, id_b);
+        SPDLOG_DEBUG("Entity {} and {} collide", id_a, id_b);
         event_distributor_.enqueue_event(
           bm::event::EntityCollide{ id_a, id_b });
       }
@@ -8,6 +8,7 @@
 #include <bm/event_distributor.hpp>
 #include <bm/interfaces/collision_world.hpp>
 #include <utils/aabb.hpp>
+#include <utils/metrics.hpp>
 #include <utils/occupancy_map.hpp>
 
 namespace bm {
@@ -26,6 +27,7 @@ public:
 
   auto begin() { return entities_.begin(); }
   auto end() { return entities_.end(); }
+  auto size() const { return entities_.size(); }
 
   auto get_player_id() -> std::optional<Entity::Id>;
   auto get_entity(Entity::Id id) -> Entity&;
@@ -33,10 +35,12 @@ public:
   auto clear() -> void;
 
   auto delete_marked_entities() -> void;
-  auto update(std::chrono::milliseconds delta) -> void;
+  auto update(std::chrono::microseconds delta) -> void;
 
   auto update_boundary(glm::vec2 top_left, glm::vec2 bottom_right) -> void;
   auto update_static_collisions(utils::OccupancyMap2D<bool> map) -> void;
+  /// @brief Update a single cell of static collisions (e.g. on map reload)
+  auto set_static_collision(glm::uvec2 cell, bool is_colliding) -> void;
 
   /* ICollisionWorld */
   auto get_world_boundaries() -> utils::AABB override final;
@@ -60,6 +64,8 @@ private:
 
   utils::AABB boundary_;
   utils::OccupancyMap2D<bool> static_collisions_;
+
+  utils::Gauge entities_gauge_{ "world_entities" };
 };
 
 } // namespace bm
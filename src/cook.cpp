@@ -0,0 +1,108 @@
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <lyra/lyra.hpp>
+#include <spdlog/cfg/env.h>
+#include <spdlog/spdlog.h>
+
+#include <bm/level.hpp>
+#include <bm/level_pack.hpp>
+#include <render/loader.hpp>
+#include <render/tiled_map.hpp>
+#include <render/tileset.hpp>
+#include <utils/json.hpp>
+
+enum ReturnCodes
+{
+  success = 0,
+  parsing_error = 1,
+  runtime_error = 2
+};
+
+/**
+ * @brief Cooks a level (and all assets it references) into a `bm::LevelPack`
+ *
+ * The pack is written next to the level definition (with .pack extension)
+ * unless an output path is given.
+ */
+int
+main(int argc, const char* argv[])
+{
+  spdlog::set_level(spdlog::level::info);
+  spdlog::cfg::load_env_levels();
+
+  std::string assets_directory{ "./assets" };
+  std::string level{ "levels/default.json" };
+  std::string output;
+  bool no_palette = false;
+
+  auto cli = lyra::cli() |
+             lyra::opt(assets_directory, "assets")["-a"]["--assets"](
+               "Path to assets directory") |
+             lyra::opt(level, "level")["-l"]["--level"](
+               "Level definition (JSON), relative to assets") |
+             lyra::opt(output, "output")["-o"]["--output"](
+               "Output pack (default: level with .pack extension)") |
+             lyra::opt(no_palette)["--no-palette"](
+               "Store images as 32-bit RGBA, even if they fit a palette");
+
+  const auto result = cli.parse({ argc, argv });
+  if (!result) {
+    spdlog::error("Failed to parse cli: {}", result.message());
+    return ReturnCodes::parsing_error;
+  }
+
+  try {
+    const auto assets = std::filesystem::path{ assets_directory };
+    const auto level_path = assets / level;
+    const auto output_path =
+      output.empty()
+        ? std::filesystem::path{ level_path }.replace_extension(".pack")
+        : std::filesystem::path{ output };
+
+    const bm::Level::Settings settings = utils::read_json(level_path);
+    std::vector<std::filesystem::path> sources{ level_path };
+
+    // Tilesets (the "default" one first)
+    std::vector<bm::LevelPack::NamedTileset> tilesets;
+    const auto cook_tileset = [&](std::string name,
+                                  const std::filesystem::path& path) {
+      spdlog::info("Cooking tileset '{}'", path.c_str());
+      auto decoded = render::Tileset::decode_tileset(path);
+      if (not no_palette) {
+        // Palettized images take a quarter of memory (and upload bandwidth)
+        if (auto image = render::palettize_image(decoded.image_)) {
+          decoded.image_ = std::move(*image);
+        } else {
+          spdlog::info("Tileset '{}' has too many colors for a palette",
+                       path.c_str());
+        }
+      }
+      sources.push_back(path);
+      sources.push_back(decoded.image_path_);
+      tilesets.push_back({ std::move(name), std::move(decoded) });
+    };
+
+    cook_tileset("default", assets / settings.tileset_name);
+    for (const auto& tileset_path : settings.tilesets) {
+      cook_tileset(tileset_path, assets / tileset_path);
+    }
+
+    // Map
+    const auto map_path = assets / settings.tilemap_path;
+    spdlog::info("Cooking map '{}'", map_path.c_str());
+    const auto map = render::TiledMap::load_map(map_path, nullptr);
+    sources.push_back(map_path);
+
+    bm::LevelPack::write(output_path, sources, settings, *map, tilesets);
+    spdlog::info("Written '{}' ({} bytes)",
+                 output_path.c_str(),
+                 std::filesystem::file_size(output_path));
+  } catch (std::exception& e) {
+    spdlog::critical("Cooking failed: {}", e.what());
+    return ReturnCodes::runtime_error;
+  }
+
+  return ReturnCodes::success;
+}
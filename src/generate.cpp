@@ -0,0 +1,81 @@
+#include <filesystem>
+#include <string>
+
+#include <lyra/lyra.hpp>
+#include <spdlog/cfg/env.h>
+#include <spdlog/spdlog.h>
+
+#include <bm/level.hpp>
+#include <bm/level_generator.hpp>
+#include <utils/json.hpp>
+
+enum ReturnCodes
+{
+  success = 0,
+  parsing_error = 1,
+  runtime_error = 2
+};
+
+/**
+ * @brief Generates a synthetic level (see `bm::LevelGenerator`)
+ *
+ * The level is written into assets (definition & Tiled map), so it can be
+ * played (b0mb3rman --level), simulated headless (b0mb3rman-replay --ticks)
+ * or cooked.
+ */
+int
+main(int argc, const char* argv[])
+{
+  spdlog::set_level(spdlog::level::info);
+  spdlog::cfg::load_env_levels();
+
+  std::string assets_directory{ "./assets" };
+  std::string level{ "levels/stress.json" };
+  std::string base_level{ "levels/default.json" };
+  unsigned size = 0;
+  bm::LevelGenerator::Settings settings;
+
+  auto cli =
+    lyra::cli() |
+    lyra::opt(assets_directory, "assets")["-a"]["--assets"](
+      "Path to assets directory") |
+    lyra::opt(level, "level")["-o"]["--output"](
+      "Level definition (JSON) to write, relative to assets") |
+    lyra::opt(base_level, "level")["--base"](
+      "Level, whose tilesets are used, relative to assets") |
+    lyra::opt(size, "tiles")["-s"]["--size"]("Width & height of map") |
+    lyra::opt(settings.width, "tiles")["--width"]("Width of map") |
+    lyra::opt(settings.height, "tiles")["--height"]("Height of map") |
+    lyra::opt(settings.wall_density, "ratio")["--walls"](
+      "Ratio of pillars, which are walls (0 - 1)") |
+    lyra::opt(settings.crate_density, "ratio")["--crates"](
+      "Ratio of free cells with a crate (0 - 1)") |
+    lyra::opt(settings.npc_density, "ratio")["--npcs"](
+      "Ratio of free cells (without crate) with an NPC (0 - 1)") |
+    lyra::opt(settings.seed, "seed")["--seed"]("Seed of generator");
+
+  const auto result = cli.parse({ argc, argv });
+  if (!result) {
+    spdlog::error("Failed to parse cli: {}", result.message());
+    return ReturnCodes::parsing_error;
+  }
+  if (size > 0) {
+    settings.width = size;
+    settings.height = size;
+  }
+
+  try {
+    const auto assets = std::filesystem::path{ assets_directory };
+    const bm::Level::Settings base = utils::read_json(assets / base_level);
+    const auto written =
+      bm::LevelGenerator::write_level(settings, assets, level, base);
+    spdlog::info("Level '{}' (map '{}') generated",
+                 level,
+                 written.tilemap_path);
+  } catch (std::exception& e) {
+    spdlog::critical("Generating failed: {}", e.what());
+    return ReturnCodes::runtime_error;
+  }
+
+  return ReturnCodes::success;
+}
@@ -3,11 +3,16 @@
 
 #include <lyra/lyra.hpp>
 #include <nlohmann/json.hpp>
+#include <spdlog/async.h>
 #include <spdlog/cfg/env.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
 #include <bm/game.hpp>
 #include <render/window.hpp>
+#include <utils/metrics.hpp>
+#include <utils/profiler.hpp>
+#include <utils/raii_helpers.hpp>
 
 enum ReturnCodes
 {
@@ -16,17 +21,60 @@ enum ReturnCodes
   runtime_error = 2
 };
 
+/// @brief Messages queued for the logging thread at most
+constexpr std::size_t log_queue_size = 8192;
+
 int
 main(int argc, const char* argv[])
 {
-  spdlog::set_level(spdlog::level::trace);
+  // Messages are formatted and written by a background thread. When it falls
+  // behind, the oldest queued messages are dropped (frames are not blocked).
+  spdlog::init_thread_pool(log_queue_size, 1);
+  spdlog::set_default_logger(
+    spdlog::create_async_nb<spdlog::sinks::stdout_color_sink_mt>("b0mb3rman"));
+  const auto flush_logs = utils::make_raii_action([]() { spdlog::shutdown(); });
+
+  // Levels below SPDLOG_ACTIVE_LEVEL are compiled out (see CMake option
+  // b0mb3rman_LOG_LEVEL), the rest is logged unless SPDLOG_LEVEL says else
+  spdlog::set_level(
+    static_cast<spdlog::level::level_enum>(SPDLOG_ACTIVE_LEVEL));
   spdlog::cfg::load_env_levels();
 
   bm::Game::Settings settings;
   settings.assets_directory = std::filesystem::path{ "./assets" };
 
+  std::string level{ settings.level.string() };
+  std::string trace_file;
+  std::string metrics_file;
+  std::string journal_file;
+  unsigned metrics_interval = 10;
+  int swap_interval = -1;
+
   // Parse arguments
-  auto cli = lyra::cli();
+  auto cli =
+    lyra::cli() |
+    lyra::opt(level, "level")["-l"]["--level"](
+      "Level definition (JSON), relative to assets") |
+    lyra::opt(settings.hot_reload)["--hot-reload"](
+      "Reload assets, when they change on disk") |
+    lyra::opt(settings.application.target_fps, "fps")["--fps"](
+      "Limit frame rate (default: unlimited)") |
+    lyra::opt(swap_interval, "interval")["--swap-interval"](
+      "Display refreshes per frame (0: no vsync, default: driver's)") |
+    lyra::opt(settings.profiler_overlay)["--profiler-overlay"](
+      "Show timings of frame's stages (F3 toggles)") |
+    lyra::opt(trace_file, "trace_file")["--trace"](
+      "On exit, write recent profiler zones as Chrome trace (JSON)") |
+    lyra::opt(metrics_file, "metrics_file")["--metrics"](
+      "Periodically write runtime metrics (Prometheus text format)") |
+    lyra::opt(metrics_interval, "seconds")["--metrics-interval"](
+      "Period of writing metrics (default: 10 seconds)") |
+    lyra::opt(settings.simulation.fixed_timestep)["--fixed-timestep"](
+      "Simulate in fixed ticks (deterministic, implied by --record)") |
+    lyra::opt(settings.simulation.seed, "seed")["--seed"](
+      "Seed of game's random generators") |
+    lyra::opt(journal_file, "journal")["--record"](
+      "Record inputs into a journal (replayed by b0mb3rman-replay)");
   /*lyra::opt(settings.tileset_name, "tileset_path")["-t"]["--tileset_path"](
     "Path to tile set definition (JSON)") |
   lyra::opt(settings.tilemap_path, "tilemap_path")["-t"]["--tilemap_path"](
@@ -37,6 +85,16 @@ main(int argc, const char* argv[])
     spdlog::error("Failed to parse cli");
     return ReturnCodes::parsing_error;
   }
+  settings.level = level;
+  if (swap_interval >= 0) {
+    settings.application.swap_interval = swap_interval;
+  }
+  settings.metrics_file = metrics_file;
+  settings.metrics_interval = std::chrono::seconds{ metrics_interval };
+  if (not journal_file.empty()) {
+    settings.simulation.journal = journal_file;
+    settings.simulation.fixed_timestep = true;
+  }
 
   // Initialize and run the game
   try {
@@ -50,6 +108,15 @@ main(int argc, const char* argv[])
     app.run();
     spdlog::info("Terminating ...");
 
+    if (not trace_file.empty()) {
+      utils::Profiler::get().write_chrome_trace(trace_file);
+      spdlog::info("Profiler trace written to '{}'", trace_file);
+    }
+    if (not metrics_file.empty()) {
+      utils::MetricsRegistry::get().write_prometheus(
+        std::filesystem::path{ metrics_file });
+    }
+
   } catch (std::exception& e) {
     spdlog::critical("Application exception: {}", e.what());
     return ReturnCodes::runtime_error;
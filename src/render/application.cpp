@@ -6,27 +6,57 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <utils/allocation_tracker.hpp>
+#include <utils/profiler.hpp>
+
 using namespace render;
 
-Application::Application(render::interfaces::IRenderable& renderable)
+Application::Application(render::interfaces::IRenderable& renderable,
+                         Settings settings)
   : renderable_{ renderable }
+  , settings_{ settings }
+  , frame_pacer_{ settings.target_fps }
 {
 }
 
 auto
 Application::run() -> void
 {
-  auto last_tick = std::chrono::high_resolution_clock::now();
+  if (settings_.swap_interval) {
+    glfwSwapInterval(*settings_.swap_interval);
+  }
+  frame_pacer_.set_target_fps(settings_.target_fps);
+  auto last_frame = FramePacer::Clock::now();
+  auto last_allocations = utils::AllocationTracker::get_thread_counters();
 
   is_running_ = true;
   while (is_running_) {
     using namespace gl;
 
-    auto now = std::chrono::high_resolution_clock::now();
-    const auto elapsed = now - last_tick;
-    last_tick = now;
-    on_render(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed));
-    renderable_.swap_buffers();
+    {
+      PROFILE_ZONE("frame pacing");
+      frame_pacer_.wait();
+    }
+    {
+      PROFILE_ZONE("frame");
+      const auto delta = std::chrono::duration_cast<std::chrono::microseconds>(
+        FramePacer::Clock::now() - last_frame);
+      // Truncated remainder is left for the next frame (no drift)
+      last_frame += delta;
+      frame_statistics_.record(delta);
+      frame_time_.record(delta);
+      on_render(delta);
+
+      PROFILE_ZONE("swap buffers");
+      renderable_.swap_buffers();
+    }
+    if constexpr (utils::AllocationTracker::is_enabled) {
+      const auto allocations = utils::AllocationTracker::get_thread_counters();
+      frame_allocations_.record(allocations.allocations_ -
+                                last_allocations.allocations_);
+      last_allocations = allocations;
+    }
+    utils::Profiler::get().end_frame();
   }
 }
 
@@ -37,7 +67,7 @@ Application::stop() -> void
 }
 
 auto
-Application::on_render(std::chrono::milliseconds delta) -> void
+Application::on_render(std::chrono::microseconds delta) -> void
 {
 }
 
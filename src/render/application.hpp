@@ -3,12 +3,16 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <optional>
 
+#include <render/frame_pacer.hpp>
+#include <render/frame_statistics.hpp>
 #include <render/interfaces/input_listener.hpp>
 #include <render/interfaces/renderable.hpp>
 #include <render/interfaces/renderable_observer.hpp>
 #include <utils/exceptions.hpp>
 #include <utils/manager.hpp>
+#include <utils/metrics.hpp>
 #include <utils/raii_helpers.hpp>
 #include <utils/type.hpp>
 
@@ -20,15 +24,28 @@ class Application
 
 {
 public:
-  class Settings
-  {};
+  struct Settings
+  {
+    /// @brief Frames per second at most (0: unlimited)
+    unsigned target_fps{ 0 };
+    /// @brief Display refreshes per buffer swap (glfwSwapInterval, 0: no
+    /// vsync, nullopt: driver's default)
+    std::optional<int> swap_interval;
+  };
 
-  explicit Application(render::interfaces::IRenderable& renderable);
+  Application(render::interfaces::IRenderable& renderable, Settings settings);
 
   auto run() -> void;
   auto stop() -> void;
 
-  virtual auto on_render(std::chrono::milliseconds delta) -> void;
+  /// @brief Times between starts of recent frames
+  auto get_frame_statistics() const -> const FrameStatistics&
+  {
+    return frame_statistics_;
+  }
+
+  /// @param delta Time since the previous frame
+  virtual auto on_render(std::chrono::microseconds delta) -> void;
 
   /* InputListener */
   virtual auto on_key_callback(int key, int scancode, int action, int mods)
@@ -40,7 +57,14 @@ public:
 
 private:
   render::interfaces::IRenderable& renderable_;
+  Settings settings_;
   std::atomic<bool> is_running_{ true };
+
+  FramePacer frame_pacer_;
+  FrameStatistics frame_statistics_;
+  utils::Histogram frame_time_{ "frame_time_nanoseconds" };
+  /// @brief Recorded with allocation tracking only
+  utils::Histogram frame_allocations_{ "frame_allocations" };
 };
 
 } // namespace bm
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include <render/font_manager.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <glbinding/gl/gl.h>
+#include <spdlog/spdlog.h>
+
+#include <utils/exceptions.hpp>
+#include <utils/opengl.hpp>
+#include <utils/raii_helpers.hpp>
+#include <utils/singleton.hpp>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_MODULE_H
+
+using namespace render;
+
+namespace {
+/// @brief Characters, rasterized into the glyph atlas
+constexpr auto atlas_first_character = 32;
+constexpr auto atlas_last_character = 126;
+constexpr auto atlas_width = 1024u;
+
+/// @brief Max. distance (in pixels) encoded in SDF
+constexpr auto sdf_spread = 8;
+/// @brief Empty texels between glyphs in atlas, so that linear filtering at
+/// edges of a glyph's quad doesn't pick up its neighbours
+constexpr auto atlas_padding = 2u;
+
+class FreeTypeLibraryHandle : public utils::Singleton<FreeTypeLibraryHandle>
+{
+public:
+  friend utils::Singleton<FreeTypeLibraryHandle>;
+
+  FreeTypeLibraryHandle()
+  {
+    SPDLOG_TRACE("FreeTypeLibraryHandle");
+    auto error = ::FT_Init_FreeType(&library_);
+    utils::throw_runtime_on_false(error == 0,
+                                  "Failed to initialize FreeType library");
+
+    // Wider spread keeps edges smooth when glyphs are up-scaled
+    ::FT_Int spread = sdf_spread;
+    ::FT_Property_Set(library_, "sdf", "spread", &spread);
+  }
+
+  ~FreeTypeLibraryHandle() { FT_Done_FreeType(library_); }
+
+  auto create_face(const std::filesystem::path& font, unsigned pixel_size)
+    -> utils::RaiiOwnership<::FT_FaceRec_>
+  {
+    ::FT_Face face = nullptr;
+    auto error = ::FT_New_Face(library_, font.c_str(), 0, &face);
+
+    utils::throw_runtime_on_false(
+      error != ::FT_Err_Unknown_File_Format,
+      fmt::format("Unknown file format {}", font.c_str()));
+    utils::throw_runtime_on_false(
+      error == 0, fmt::format("Failed to load font {}", font.c_str()));
+
+    ::FT_Set_Pixel_Sizes(face, 0, pixel_size);
+
+    return utils::make_raii_deleter<::FT_FaceRec_>(
+      face, [](::FT_Face face) { ::FT_Done_Face(face); });
+  }
+
+private:
+  ::FT_Library library_;
+};
+} // namespace
+
+auto
+Font::get_glyph(char c) const -> const Glyph*
+{
+  const auto& glyph = glyphs_.at(static_cast<unsigned char>(c));
+  return glyph ? &glyph.value() : nullptr;
+}
+
+auto
+Font::compute_text_metrics(const std::string& text, float size) const
+  -> glm::vec2
+{
+  glm::vec2 result{ 0 };
+  for (const auto& c : text) {
+    if (const auto* glyph = get_glyph(c)) {
+      result += glyph->advance;
+    }
+  }
+  return result * (size / base_size_);
+}
+
+auto
+Font::load_font(const std::filesystem::path& file)
+  -> std::shared_ptr<render::Font>
+{
+  SPDLOG_TRACE("Font::load_font: '{}'", file.c_str());
+  auto font = std::make_shared<render::Font>();
+  auto face = FreeTypeLibraryHandle::get_instance().create_face(
+    file, static_cast<unsigned>(font->base_size_));
+
+  // I. rasterize printable ASCII as SDF & pack glyphs into rows (shelves)
+  struct PlacedBitmap
+  {
+    glm::uvec2 position;
+    glm::uvec2 size;
+    std::vector<unsigned char> pixels;
+  };
+  std::vector<PlacedBitmap> bitmaps;
+
+  glm::uvec2 pen{ 0, 0 };
+  unsigned row_height = 0;
+  for (int c = atlas_first_character; c <= atlas_last_character; c++) {
+    if (::FT_Load_Char(face.get(), c, FT_LOAD_DEFAULT) or
+        ::FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF)) {
+      continue;
+    }
+
+    const auto& g = face->glyph;
+    const auto size = glm::uvec2(g->bitmap.width, g->bitmap.rows);
+    if (pen.x + size.x > atlas_width) {
+      pen = glm::uvec2(0, pen.y + row_height + atlas_padding);
+      row_height = 0;
+    }
+
+    PlacedBitmap bitmap{ pen, size, {} };
+    for (unsigned row = 0; row < size.y; row++) {
+      const auto* row_data = g->bitmap.buffer + row * g->bitmap.pitch;
+      bitmap.pixels.insert(bitmap.pixels.end(), row_data, row_data + size.x);
+    }
+    bitmaps.emplace_back(std::move(bitmap));
+
+    font->glyphs_.at(c) =
+      Glyph{ glm::vec2(size),
+             glm::vec2(g->bitmap_left, g->bitmap_top),
+             glm::vec2(g->advance.x, g->advance.y) / glm::vec2(64),
+             glm::vec2(pen),
+             glm::vec2(pen + size) };
+
+    pen.x += size.x + atlas_padding;
+    row_height = std::max(row_height, size.y);
+  }
+
+  // II. compose the atlas
+  const auto atlas_height = std::max(pen.y + row_height, 1u);
+  std::vector<unsigned char> atlas(atlas_width * atlas_height, 0);
+  for (const auto& bitmap : bitmaps) {
+    for (unsigned row = 0; row < bitmap.size.y; row++) {
+      std::copy_n(bitmap.pixels.begin() + row * bitmap.size.x,
+                  bitmap.size.x,
+                  atlas.begin() + (bitmap.position.y + row) * atlas_width +
+                    bitmap.position.x);
+    }
+  }
+
+  // Normalize texel positions to UV
+  const auto atlas_size = glm::vec2(atlas_width, atlas_height);
+  for (auto& glyph : font->glyphs_) {
+    if (glyph) {
+      glyph->uv_min /= atlas_size;
+      glyph->uv_max /= atlas_size;
+    }
+  }
+
+  // III. upload
+  font->atlas_ = render::create_texture();
+  gl::glBindTexture(gl::GL_TEXTURE_2D, font->atlas_);
+
+  gl::glTexParameteri(
+    gl::GL_TEXTURE_2D, gl::GL_TEXTURE_WRAP_S, gl::GL_CLAMP_TO_EDGE);
+  gl::glTexParameteri(
+    gl::GL_TEXTURE_2D, gl::GL_TEXTURE_WRAP_T, gl::GL_CLAMP_TO_EDGE);
+  gl::glTexParameteri(
+    gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MIN_FILTER, gl::GL_LINEAR);
+  gl::glTexParameteri(
+    gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MAG_FILTER, gl::GL_LINEAR);
+
+  gl::glPixelStorei(gl::GL_UNPACK_ALIGNMENT, 1);
+  gl::glTexImage2D(gl::GL_TEXTURE_2D,
+                   0,
+                   gl::GL_RED,
+                   atlas_width,
+                   atlas_height,
+                   0,
+                   gl::GL_RED,
+                   gl::GL_UNSIGNED_BYTE,
+                   atlas.data());
+  gl::glBindTexture(gl::GL_TEXTURE_2D, 0);
+  utils::throw_on_opengl_error(
+    fmt::format("Failed to upload glyph atlas of {}", file.c_str()));
+
+  return font;
+}
+
+FontManager::FontManager(std::filesystem::path fonts_directory)
+  : fonts_directory_{ std::move(fonts_directory) }
+{
+}
+
+auto
+FontManager::get_font(const std::string& name) -> std::shared_ptr<const Font>
+{
+  if (not fonts_.has_entity(name)) {
+    fonts_.create_named(name, Font::load_font(fonts_directory_ / name));
+  }
+  return fonts_.get_entity(name);
+}
+
+auto
+FontManager::has_font(const std::string& name) const -> bool
+{
+  return fonts_.has_entity(name);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <glm/glm.hpp>
+
+#include <render/resource.hpp>
+#include <utils/entity_registry.hpp>
+
+namespace render {
+
+/**
+ * @brief Font face, rasterized into a signed-distance-field glyph atlas
+ *
+ * Glyphs are rasterized once at `base_size_`. As the atlas stores distances
+ * instead of coverage, the same atlas is used to render any text size.
+ */
+struct Font
+{
+  /**
+   * @brief Placement and metrics of a single glyph (in `base_size_` pixels)
+   *
+   */
+  struct Glyph
+  {
+    glm::vec2 size;
+    glm::vec2 bearing;
+    glm::vec2 advance;
+    glm::vec2 uv_min;
+    glm::vec2 uv_max;
+  };
+
+  /// @brief Pixel size the atlas has been rasterized with
+  float base_size_{ 48.0f };
+  /// @brief Single-channel SDF atlas (0.5: glyph's edge)
+  Texture atlas_;
+  /// @brief Glyphs in atlas (indexed by character)
+  std::array<std::optional<Glyph>, 256> glyphs_;
+
+  auto get_glyph(char c) const -> const Glyph*;
+
+  /// @brief Size of `text` when rendered with `size` pixels
+  auto compute_text_metrics(const std::string& text, float size) const
+    -> glm::vec2;
+
+  static auto load_font(const std::filesystem::path& file)
+    -> std::shared_ptr<render::Font>;
+};
+
+/**
+ * @brief Loads fonts (once) and shares them between renderers
+ *
+ * Fonts are identified by their path relative to `fonts_directory`.
+ */
+class FontManager
+{
+public:
+  explicit FontManager(std::filesystem::path fonts_directory);
+
+  /// @brief Get font by name, loading it on first use
+  auto get_font(const std::string& name) -> std::shared_ptr<const Font>;
+  auto has_font(const std::string& name) const -> bool;
+
+private:
+  std::filesystem::path fonts_directory_;
+  utils::EntityNamedRegistry<std::shared_ptr<const Font>> fonts_;
+};
+
+} // namespace render
@@ -1,22 +1,23 @@
 #include <render/font_renderer.hpp>
 
+#include <vector>
+
 #include <glbinding/glbinding.h>
+#include <render/font_manager.hpp>
+#include <render/render_queue.hpp>
 #include <render/resource.hpp>
+#include <render/stream_buffer.hpp>
 #include <render/tile_program.hpp>
 #include <render/viewport.hpp>
 
+#include <utils/metrics.hpp>
 #include <utils/opengl.hpp>
-#include <utils/raii_helpers.hpp>
-#include <utils/singleton.hpp>
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/matrix_operation.hpp>
 #include <glm/gtx/transform.hpp>
 
-#include <ft2build.h>
-#include FT_FREETYPE_H
-
 using namespace render;
 namespace {
 // Taken from
@@ -27,12 +28,16 @@ const std::string font_rendering_vertex_shader =
 layout (location = 0) in vec4 coord;
 out vec2 texcoord;
 uniform mat4 projection;
+uniform vec2 origin;
+uniform float wave_phase;
+uniform float wave_amplitude;
 
 void main(void) {
-  vec4 coord_out = projection * vec4(coord.xy, 0,1);
+  vec2 position = origin + coord.xy;
+  position.y += wave_amplitude * sin(wave_phase);
+  vec4 coord_out = projection * vec4(position, 0,1);
   gl_Position = coord_out;
   gl_Position.y = gl_Position.y*-1;
-  //gl_Position = vec4(coord.xy, 0, 1);
   texcoord = coord.zw;
 }
 )";
@@ -45,56 +50,54 @@ const std::string font_rendering_fragment_shader =
 out vec4 FragColor;
 in vec2 texcoord;
 uniform sampler2D tex;
-uniform vec4 color;
+uniform float opacity;
 
 void main(void) {
-  FragColor = vec4(1, 1, 1, texture2D(tex, texcoord).r);
-  //FragColor = vec4(1, 1, 1, 1);
+  // Signed distance field: 0.5 is glyph's edge, antialiased over ~1 pixel
+  float distance = texture(tex, texcoord).r;
+  float smoothing = fwidth(distance);
+  float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+  FragColor = vec4(1, 1, 1, opacity * alpha);
 }
 )";
 
-class FreeTypeLibraryHandle : public utils::Singleton<FreeTypeLibraryHandle>
-{
-public:
-  friend utils::Singleton<FreeTypeLibraryHandle>;
-
-  FreeTypeLibraryHandle()
-  {
-    spdlog::trace("FreeTypeLibraryHandle");
-    auto error = ::FT_Init_FreeType(&library_);
-    utils::throw_runtime_on_false(error == 0,
-                                  "Failed to initialize FreeType library");
-  }
-
-  ~FreeTypeLibraryHandle() { FT_Done_FreeType(library_); }
-
-  auto create_face(const std::filesystem::path& font) -> ::FT_Face&
-  {
-    auto error = ::FT_New_Face(library_, font.c_str(), 0, &face_);
+/// @brief Size of a single stream buffer's region (in bytes)
+constexpr gl::GLsizeiptr text_stream_region_size = 64 * 1024;
 
-    utils::throw_runtime_on_false(
-      error != ::FT_Err_Unknown_File_Format,
-      fmt::format("Unknown file format {}", font.c_str()));
+/// @brief Vertices of a glyph quad (two triangles)
+constexpr std::size_t vertices_per_glyph = 6;
+} // namespace
 
-    ::FT_Set_Pixel_Sizes(face_, 0, 48);
+class FontRenderer::TextLayout
+{
+public:
+  render::VertexArray vao_;
+  render::Buffer vbo_;
+  gl::GLsizei vertex_count_{ 0 };
 
-    return face_;
-  }
+  /// @brief Font, whose atlas is referenced by quads' UVs
+  std::shared_ptr<const Font> font_;
 
-private:
-  ::FT_Library library_;
-  ::FT_Face face_;
+  /// @brief Size of text (in pixels)
+  glm::vec2 size_{ 0 };
 };
-} // namespace
 
 class FontRenderer::FontRendererImpl
 {
 public:
   FontRendererImpl(const Viewport& viewport,
-                   const std::filesystem::path& font_path)
+                   RenderQueue& queue,
+                   FontManager& font_manager,
+                   const std::string& default_font_name)
     : viewport_{ viewport }
+    , queue_{ queue }
+    , font_manager_{ font_manager }
+    , default_font_name_{ default_font_name }
+    , stream_buffer_{ text_stream_region_size }
+    , stream_vao_{ render::create_vertex_array() }
   {
-    face_ = FreeTypeLibraryHandle::get_instance().create_face(font_path);
+    // I. Load (or reuse) the default font
+    font_manager_.get_font(default_font_name_);
 
     // II. Create rendering shdaders
     std::vector<Shader> shaders;
@@ -109,149 +112,292 @@ public:
     gl::glUniform1i(texture_uniform_location, 0);
     gl::glUseProgram(0);
 
-    // III. create texture & set params
-    texture_ = std::move(render::create_texture());
-    gl::glBindTexture(gl::GL_TEXTURE_2D, texture_);
+    uniforms_.projection = gl::glGetUniformLocation(program_, "projection");
+    uniforms_.origin = gl::glGetUniformLocation(program_, "origin");
+    uniforms_.opacity = gl::glGetUniformLocation(program_, "opacity");
+    uniforms_.wave_phase = gl::glGetUniformLocation(program_, "wave_phase");
+    uniforms_.wave_amplitude =
+      gl::glGetUniformLocation(program_, "wave_amplitude");
 
-    gl::glTexParameteri(
-      gl::GL_TEXTURE_2D, gl::GL_TEXTURE_WRAP_S, gl::GL_CLAMP_TO_EDGE);
-    gl::glTexParameteri(
-      gl::GL_TEXTURE_2D, gl::GL_TEXTURE_WRAP_T, gl::GL_CLAMP_TO_EDGE);
-
-    gl::glTexParameteri(
-      gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MIN_FILTER, gl::GL_LINEAR);
-    gl::glTexParameteri(
-      gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MAG_FILTER, gl::GL_LINEAR);
-
-    gl::glPixelStorei(gl::GL_UNPACK_ALIGNMENT, 1);
-
-    gl::glBindTexture(gl::GL_TEXTURE_2D, 0);
-
-    // III. create geometry, representing a glyph
-
-    vao_ = render::create_vertex_array();
-    vbo_ = render::create_buffer();
-    ebo_ = render::create_buffer();
-
-    gl::glBindVertexArray(vao_);
+    // III. Vertex array for uncached text, sourcing the stream buffer
+    gl::glBindVertexArray(stream_vao_);
+    gl::glBindBuffer(gl::GL_ARRAY_BUFFER, stream_buffer_.get_buffer());
     gl::glEnableVertexAttribArray(0);
-    gl::glBindBuffer(gl::GL_ARRAY_BUFFER, vbo_);
     gl::glVertexAttribPointer(0, 4, gl::GL_FLOAT, gl::GL_FALSE, 0, 0);
-
-    gl::glBindBuffer(gl::GL_ELEMENT_ARRAY_BUFFER, ebo_);
-    gl::GLuint indices[] = { 0, 1, 2, 3 };
-    gl::glBufferData(
-      gl::GL_ELEMENT_ARRAY_BUFFER, sizeof indices, indices, gl::GL_STATIC_DRAW);
     gl::glBindVertexArray(0);
+    gl::glBindBuffer(gl::GL_ARRAY_BUFFER, 0);
+
     utils::throw_on_opengl_error(
-      "OpenGL error after creating VBO for FontRenderer");
+      "OpenGL error after creating program for FontRenderer");
   }
 
-  auto compute_text_metrics(const std::string& text) -> glm::vec2
+  auto compute_text_metrics(const std::string& text,
+                            const std::string& font_name,
+                            float size) -> glm::vec2
   {
+    const auto font = get_font(font_name);
+    return font->compute_text_metrics(text, resolve_size(*font, size));
+  }
 
-    glm::vec2 size{ 0 };
-    for (const auto& c : text) {
-      if (::FT_Load_Char(face_, c, FT_LOAD_RENDER))
-        continue;
+  auto create_text_layout(const std::string& text,
+                          const std::string& font_name,
+                          float size) -> std::shared_ptr<TextLayout>
+  {
+    auto layout = std::make_shared<TextLayout>();
+    layout->font_ = get_font(font_name);
+    std::vector<glm::vec4> vertices;
+    layout_glyphs(text, *layout->font_, size, layout->size_, vertices);
+    layout->vertex_count_ = static_cast<gl::GLsizei>(vertices.size());
+    layout->vao_ = render::create_vertex_array();
+    layout->vbo_ = render::create_buffer();
+
+    gl::glBindVertexArray(layout->vao_);
+    gl::glBindBuffer(gl::GL_ARRAY_BUFFER, layout->vbo_);
+    gl::glBufferData(gl::GL_ARRAY_BUFFER,
+                     vertices.size() * sizeof(glm::vec4),
+                     vertices.data(),
+                     gl::GL_STATIC_DRAW);
+    glyph_quads_.increment(vertices.size() / vertices_per_glyph);
+    gl::glEnableVertexAttribArray(0);
+    gl::glVertexAttribPointer(0, 4, gl::GL_FLOAT, gl::GL_FALSE, 0, 0);
+    gl::glBindVertexArray(0);
+    gl::glBindBuffer(gl::GL_ARRAY_BUFFER, 0);
 
-      const auto& g = face_->glyph;
-      size += glm::vec2(g->advance.x, g->advance.y) / glm::vec2(64);
-    }
-    return size;
+    return layout;
   }
 
+  auto draw_text(const TextLayout& layout,
+                 glm::vec2 origin,
+                 bool position_relative,
+                 TextStyle style) -> void
+  {
+    draw_vertices(layout.vao_,
+                  0,
+                  layout.vertex_count_,
+                  *layout.font_,
+                  layout.size_,
+                  origin,
+                  position_relative,
+                  style);
+  }
+
+  /// @brief Draw text, whose glyph quads are streamed instead of cached
   auto draw_text(const std::string& text,
                  glm::vec2 origin,
-                 bool position_relative = false) -> void
+                 bool position_relative) -> void
   {
-    gl::glUseProgram(program_);
-    const auto viewport_min = viewport_.get_origin();
-    const auto viewport_max = viewport_.get_origin() + viewport_.get_size();
-    auto matrix = glm::ortho(
-      viewport_min.x, viewport_max.x, viewport_min.y, viewport_max.y);
-    {
-      auto location = gl::glGetUniformLocation(program_, "projection");
-      gl::glUniformMatrix4fv(location, 1, gl::GL_FALSE, glm::value_ptr(matrix));
+    const auto font = get_font("");
+    glm::vec2 text_size{ 0 };
+    layout_glyphs(text, *font, 0, text_size, stream_vertices_);
+    const auto count = static_cast<gl::GLsizei>(stream_vertices_.size());
+    glyph_quads_.increment(stream_vertices_.size() / vertices_per_glyph);
+    draw_vertices(stream_vao_,
+                  0,
+                  count,
+                  *font,
+                  text_size,
+                  origin,
+                  position_relative,
+                  TextStyle{},
+                  stream_vertices_);
+  }
+
+private:
+  /**
+   * @brief Lay out `text` into glyph quads
+   *
+   * @param text_size[out] Size of text (in pixels)
+   * @param vertices[out] Two triangles per glyph, vertex: (x, y, u, v)
+   */
+  auto layout_glyphs(const std::string& text,
+                     const Font& font,
+                     float size,
+                     glm::vec2& text_size,
+                     std::vector<glm::vec4>& vertices) const -> void
+  {
+    const auto scale = resolve_size(font, size) / font.base_size_;
+
+    vertices.clear();
+    vertices.reserve(text.size() * vertices_per_glyph);
+
+    glm::vec2 position{ 0 };
+    for (const auto& c : text) {
+      const auto* glyph = font.get_glyph(c);
+      if (not glyph) {
+        continue;
+      }
+
+      const auto glyph_size = glyph->size * scale;
+      const auto bearing = glyph->bearing * scale;
+
+      const float x1 = position.x + bearing.x;
+      const float x2 = x1 + glyph_size.x;
+      const float y1 = position.y + bearing.y - glyph_size.y;
+      const float y2 = position.y + bearing.y;
+
+      const auto top_left = glm::vec4(x1, y2, glyph->uv_min.x, glyph->uv_max.y);
+      const auto top_right =
+        glm::vec4(x2, y2, glyph->uv_max.x, glyph->uv_max.y);
+      const auto bottom_left =
+        glm::vec4(x1, y1, glyph->uv_min.x, glyph->uv_min.y);
+      const auto bottom_right =
+        glm::vec4(x2, y1, glyph->uv_max.x, glyph->uv_min.y);
+
+      vertices.insert(vertices.end(),
+                      { top_left,
+                        top_right,
+                        bottom_left,
+                        bottom_left,
+                        top_right,
+                        bottom_right });
+
+      position += glyph->advance * scale;
     }
 
-    gl::glEnable(gl::GL_BLEND);
-    gl::glBlendFunc(gl::GL_SRC_ALPHA, gl::GL_ONE_MINUS_SRC_ALPHA);
+    text_size = position;
+  }
 
-    gl::glActiveTexture(gl::GL_TEXTURE0);
-    gl::glBindTexture(gl::GL_TEXTURE_2D, texture_);
-    gl::glUseProgram(program_);
+  /**
+   * @brief Push draw of glyph quads into queue
+   *
+   * @param stream_vertices If not empty, vertices are staged in the queue and
+   * uploaded into stream buffer just before the draw (`first` is then
+   * relative to the upload)
+   */
+  auto draw_vertices(const VertexArray& vao,
+                     gl::GLint first,
+                     gl::GLsizei count,
+                     const Font& font,
+                     glm::vec2 text_size,
+                     glm::vec2 origin,
+                     bool position_relative,
+                     TextStyle style,
+                     const std::vector<glm::vec4>& stream_vertices = {}) -> void
+  {
+    if (count == 0) {
+      return;
+    }
 
-    glm::vec2 scale{ 1.0 };
     glm::vec2 position = origin;
+    float wave_reference = origin.y;
     if (position_relative) {
       // compute relative text position
-      const auto size = compute_text_metrics(text);
-      position =
-        viewport_min + viewport_.get_size() * origin - size * glm::vec2(0.5);
+      position = viewport_.get_origin() + viewport_.get_size() * origin -
+                 text_size * glm::vec2(0.5);
+      wave_reference = viewport_.get_size().y * origin.y;
     }
+    const auto wave_amplitude = style.wave_amplitude * wave_reference;
+
+    const auto vao_id = static_cast<gl::GLuint>(vao);
+    const auto state = RenderState{ program_, font.atlas_, true };
+    const auto staged_count = stream_vertices.size();
+    const auto staged =
+      stream_vertices.empty() ? 0 : queue_.stage(stream_vertices);
+    queue_.push(state, [=]() {
+      const auto viewport_min = viewport_.get_origin();
+      const auto viewport_max = viewport_min + viewport_.get_size();
+      const auto matrix = glm::ortho(
+        viewport_min.x, viewport_max.x, viewport_min.y, viewport_max.y);
+      gl::glUniformMatrix4fv(
+        uniforms_.projection, 1, gl::GL_FALSE, glm::value_ptr(matrix));
+
+      gl::glUniform2f(uniforms_.origin, position.x, position.y);
+      gl::glUniform1f(uniforms_.opacity, style.opacity);
+      gl::glUniform1f(uniforms_.wave_phase, style.wave_phase);
+      gl::glUniform1f(uniforms_.wave_amplitude, wave_amplitude);
+
+      // Upload right before the draw, so that stream buffer's fences are
+      // placed after the draws reading the data
+      auto first_vertex = first;
+      if (staged_count > 0) {
+        const auto offset =
+          stream_buffer_.upload(queue_.get_staged<glm::vec4>(staged),
+                                staged_count * sizeof(glm::vec4));
+        first_vertex += static_cast<gl::GLint>(offset / sizeof(glm::vec4));
+      }
+
+      gl::glBindVertexArray(vao_id);
+      gl::glDrawArrays(gl::GL_TRIANGLES, first_vertex, count);
+      gl::glBindVertexArray(0);
+    });
+  }
 
-    for (const auto& c : text) {
-      if (::FT_Load_Char(face_, c, FT_LOAD_RENDER))
-        continue;
+  /// @brief Font by name (empty name: default font)
+  auto get_font(const std::string& font_name) -> std::shared_ptr<const Font>
+  {
+    return font_manager_.get_font(font_name.empty() ? default_font_name_
+                                                    : font_name);
+  }
 
-      const auto& g = face_->glyph;
-      gl::glTexImage2D(gl::GL_TEXTURE_2D,
-                       0,
-                       gl::GL_RED,
-                       g->bitmap.width,
-                       g->bitmap.rows,
-                       0,
-                       gl::GL_RED,
-                       gl::GL_UNSIGNED_BYTE,
-                       g->bitmap.buffer);
-
-      float x2 = position.x + g->bitmap_left * scale.x;
-      float y2 = -position.y - g->bitmap_top * scale.y;
-      float w = g->bitmap.width * scale.x;
-      float h = g->bitmap.rows * scale.y;
-
-      gl::GLfloat box[4][4] = {
-        { x2, -y2, 0, 1 },
-        { x2 + w, -y2, 1, 1 },
-        { x2, -y2 - h, 0, 0 },
-        { x2 + w, -y2 - h, 1, 0 },
-      };
-
-      gl::glBindVertexArray(vao_);
-      gl::glBufferData(
-        gl::GL_ARRAY_BUFFER, sizeof box, box, gl::GL_DYNAMIC_DRAW);
-
-      gl::glDrawArrays(gl::GL_TRIANGLE_STRIP, 0, 4);
-
-      position += glm::vec2(g->advance.x, g->advance.y) / glm::vec2(64) * scale;
-    }
+  /// @brief Size in pixels (non-positive size: font's native size)
+  auto resolve_size(const Font& font, float size) const -> float
+  {
+    return size > 0 ? size : font.base_size_;
   }
 
 private:
   render::Program program_;
-  render::Texture texture_;
-  render::VertexArray vao_;
-  render::Buffer vbo_;
-  render::Buffer ebo_;
 
-  FT_Face face_;
+  struct UniformLocations
+  {
+    gl::GLint projection;
+    gl::GLint origin;
+    gl::GLint opacity;
+    gl::GLint wave_phase;
+    gl::GLint wave_amplitude;
+  } uniforms_;
 
   const Viewport& viewport_;
+  RenderQueue& queue_;
+  FontManager& font_manager_;
+  std::string default_font_name_;
+
+  /// @brief Glyph quads of uncached text
+  StreamBuffer stream_buffer_;
+  /// @brief Layout of uncached text (reused between draws)
+  std::vector<glm::vec4> stream_vertices_;
+  VertexArray stream_vao_;
+
+  /// @brief Glyph quads laid out (of cached layouts and streamed text)
+  utils::Counter glyph_quads_{ "text_glyph_quads_total" };
 };
 
 FontRenderer::FontRenderer(const Viewport& viewport,
-                           const std::string& font_name)
-  : pimpl_{ std::make_unique<FontRendererImpl>(viewport, font_name) }
+                           RenderQueue& queue,
+                           FontManager& font_manager,
+                           const std::string& default_font_name)
+  : pimpl_{ std::make_unique<FontRendererImpl>(viewport,
+                                               queue,
+                                               font_manager,
+                                               default_font_name) }
 {
 }
 
 FontRenderer::~FontRenderer() = default;
 
 auto
-FontRenderer::compute_text_metrics(const std::string& text) -> glm::vec2
+FontRenderer::compute_text_metrics(const std::string& text,
+                                   const std::string& font_name,
+                                   float size) -> glm::vec2
 {
-  return pimpl_->compute_text_metrics(text);
+  return pimpl_->compute_text_metrics(text, font_name, size);
+}
+
+auto
+FontRenderer::create_text_layout(const std::string& text,
+                                 const std::string& font_name,
+                                 float size) -> std::shared_ptr<TextLayout>
+{
+  return pimpl_->create_text_layout(text, font_name, size);
+}
+
+auto
+FontRenderer::draw_text(const TextLayout& layout,
+                        glm::vec2 origin,
+                        bool position_relative,
+                        TextStyle style) -> void
+{
+  pimpl_->draw_text(layout, origin, position_relative, style);
 }
 
 auto
@@ -260,4 +406,4 @@ FontRenderer::draw_text(const std::string& text,
                         bool position_relative) -> void
 {
   pimpl_->draw_text(text, origin, position_relative);
-}
\ No newline at end of file
+}
@@ -9,9 +9,30 @@
 
 namespace render {
 
+// Fwd
+class FontManager;
+class RenderQueue;
+
+/// @brief Per-draw text effects (applied in vertex/fragment shader)
+struct TextStyle
+{
+  /// @brief Opacity (1: opaque, 0: invisible)
+  float opacity{ 1.0f };
+  /// @brief Phase of wave effect (in radians)
+  float wave_phase{ 0.0f };
+  /// @brief Amplitude of wave effect (relative to origin's y)
+  float wave_amplitude{ 0.0f };
+};
+
 /**
  * @brief Text rendering in OpenGL via FreeType
  *
+ * Glyphs are taken from SDF atlases, shared via `FontManager`. A text is
+ * laid out into a `TextLayout` (glyph quads on GPU) that can be cached by the
+ * caller and drawn with a single draw call.
+ *
+ * Draws are pushed as commands into `RenderQueue`, hence a drawn layout must
+ * outlive submit of the queue.
  */
 class FontRenderer
 {
@@ -19,12 +40,33 @@ public:
   // Fwd declaration
   class FontRendererImpl;
 
+  /// @brief Glyph quads of a single text, uploaded to GPU
+  class TextLayout;
+
   FontRenderer() = default;
   explicit FontRenderer(const Viewport& viewport,
+                        RenderQueue& queue,
+                        FontManager& font_manager,
                         const std::string& default_font_name);
   ~FontRenderer();
 
-  auto compute_text_metrics(const std::string& text) -> glm::vec2;
+  /// @note empty `font_name` selects the default font, non-positive `size`
+  /// selects font's native size (in pixels)
+  auto compute_text_metrics(const std::string& text,
+                            const std::string& font_name = "",
+                            float size = 0) -> glm::vec2;
+
+  /// @brief Lay out `text` into glyph quads (reusable between frames)
+  auto create_text_layout(const std::string& text,
+                          const std::string& font_name = "",
+                          float size = 0) -> std::shared_ptr<TextLayout>;
+
+  auto draw_text(const TextLayout& layout,
+                 glm::vec2 origin,
+                 bool position_relative = false,
+                 TextStyle style = {}) -> void;
+
+  /// @brief Draw without caching (lays out `text` on every call)
   auto draw_text(const std::string& text,
                  glm::vec2 origin,
                  bool position_relative = false) -> void;
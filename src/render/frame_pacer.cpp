@@ -0,0 +1,42 @@
+#include <render/frame_pacer.hpp>
+
+#include <thread>
+
+using namespace render;
+
+FramePacer::FramePacer(unsigned target_fps)
+{
+  set_target_fps(target_fps);
+}
+
+auto
+FramePacer::set_target_fps(unsigned target_fps) -> void
+{
+  target_fps_ = target_fps;
+  period_ = target_fps == 0 ? Clock::duration::zero()
+                            : std::chrono::duration_cast<Clock::duration>(
+                                std::chrono::seconds{ 1 }) /
+                                target_fps;
+  next_frame_ = Clock::now();
+}
+
+auto
+FramePacer::wait() -> void
+{
+  if (period_ == Clock::duration::zero()) {
+    return;
+  }
+
+  const auto now = Clock::now();
+  if (now > next_frame_ + period_) {
+    next_frame_ = now;
+  }
+
+  if (const auto wake_up = next_frame_ - spin_duration; now < wake_up) {
+    std::this_thread::sleep_until(wake_up);
+  }
+  while (Clock::now() < next_frame_) {
+    std::this_thread::yield();
+  }
+  next_frame_ += period_;
+}
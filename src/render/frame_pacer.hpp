@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+
+namespace render {
+
+/**
+ * @brief Limits frame rate to a target FPS
+ *
+ * Waiting sleeps until `spin_duration` before frame's deadline and then
+ * spins (yielding), as sleeps overshoot by scheduler's granularity. Frames
+ * are scheduled at a steady cadence (a slightly late frame shortens the
+ * next wait), but a frame, late by more than a period (e.g. a hitch),
+ * restarts the cadence instead of rushing frames to catch up.
+ */
+class FramePacer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::chrono::microseconds spin_duration{ 1500 };
+
+  /// @param target_fps Frames per second at most (0: unlimited)
+  explicit FramePacer(unsigned target_fps = 0);
+
+  auto set_target_fps(unsigned target_fps) -> void;
+  auto get_target_fps() const -> unsigned { return target_fps_; }
+
+  /// @brief Block until the next frame is due (no-op when unlimited)
+  auto wait() -> void;
+
+private:
+  unsigned target_fps_{ 0 };
+  Clock::duration period_{ 0 };
+  Clock::time_point next_frame_;
+};
+
+} // namespace render
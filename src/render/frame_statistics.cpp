@@ -0,0 +1,68 @@
+#include <render/frame_statistics.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace render;
+
+FrameStatistics::FrameStatistics(std::size_t window_size)
+  : window_size_{ window_size }
+{
+  if (window_size == 0) {
+    throw std::runtime_error("FrameStatistics: window can't be empty");
+  }
+  frames_.reserve(window_size);
+  window_.buckets_.resize(utils::Histogram::bucket_count);
+}
+
+auto
+FrameStatistics::record(std::chrono::microseconds frame_time) -> void
+{
+  const auto value =
+    static_cast<std::uint64_t>(std::max<std::int64_t>(frame_time.count(), 0));
+
+  if (frames_.size() < window_size_) {
+    frames_.push_back(value);
+  } else {
+    // Oldest frame leaves the window
+    auto& oldest = frames_[next_];
+    window_.buckets_[utils::Histogram::get_bucket(oldest)]--;
+    window_.count_--;
+    window_.sum_ -= oldest;
+    oldest = value;
+    next_ = (next_ + 1) % frames_.size();
+  }
+
+  window_.buckets_[utils::Histogram::get_bucket(value)]++;
+  window_.count_++;
+  window_.sum_ += value;
+}
+
+auto
+FrameStatistics::get_summary() const -> Summary
+{
+  Summary summary;
+  summary.count_ = window_.count_;
+  if (window_.count_ == 0) {
+    return summary;
+  }
+
+  using std::chrono::microseconds;
+  summary.mean_ = microseconds(window_.sum_ / window_.count_);
+  summary.p50_ = microseconds(window_.get_quantile(0.50));
+  summary.p95_ = microseconds(window_.get_quantile(0.95));
+  summary.p99_ = microseconds(window_.get_quantile(0.99));
+  summary.max_ =
+    microseconds(*std::max_element(frames_.begin(), frames_.end()));
+  return summary;
+}
+
+auto
+FrameStatistics::clear() -> void
+{
+  frames_.clear();
+  next_ = 0;
+  std::fill(window_.buckets_.begin(), window_.buckets_.end(), 0);
+  window_.count_ = 0;
+  window_.sum_ = 0;
+}
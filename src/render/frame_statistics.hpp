@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <utils/metrics.hpp>
+
+namespace render {
+
+/**
+ * @brief Rolling histogram of frame times (of the last `window_size` frames)
+ *
+ * Frame times share log-linear buckets with `utils::Histogram`, so
+ * percentiles are upper bounds of their buckets (within 12.5 %). Recording
+ * is O(1), the oldest frame leaves the histogram as a new one comes. Mean
+ * and maximum are exact.
+ */
+class FrameStatistics
+{
+public:
+  static constexpr std::size_t default_window_size = 512;
+
+  struct Summary
+  {
+    std::size_t count_{ 0 };
+    std::chrono::microseconds mean_{ 0 };
+    std::chrono::microseconds p50_{ 0 };
+    std::chrono::microseconds p95_{ 0 };
+    std::chrono::microseconds p99_{ 0 };
+    std::chrono::microseconds max_{ 0 };
+  };
+
+  explicit FrameStatistics(std::size_t window_size = default_window_size);
+
+  auto record(std::chrono::microseconds frame_time) -> void;
+  /// @brief Percentiles etc. of frames in window (O(window size))
+  auto get_summary() const -> Summary;
+  auto clear() -> void;
+
+private:
+  std::size_t window_size_;
+  /// @brief Frame times (in microseconds), ring buffer
+  std::vector<std::uint64_t> frames_;
+  std::size_t next_{ 0 };
+  /// @brief Histogram of frames in window
+  utils::Histogram::Snapshot window_;
+};
+
+} // namespace render
@@ -0,0 +1,124 @@
+#include <render/gpu_timer.hpp>
+
+#include <chrono>
+
+#include <glbinding-aux/ContextInfo.h>
+#include <glbinding/Version.h>
+#include <glbinding/gl/extension.h>
+#include <spdlog/spdlog.h>
+
+#include <utils/profiler.hpp>
+
+using namespace render;
+
+namespace {
+auto
+is_timer_query_supported() -> bool
+{
+  if (glbinding::aux::ContextInfo::version() < glbinding::Version(3, 3) and
+      not glbinding::aux::ContextInfo::supported(
+        { gl::GLextension::GL_ARB_timer_query })) {
+    return false;
+  }
+
+  // Implementations may expose queries without a counter behind them
+  gl::GLint counter_bits = 0;
+  gl::glGetQueryiv(
+    gl::GL_TIME_ELAPSED, gl::GL_QUERY_COUNTER_BITS, &counter_bits);
+  return counter_bits > 0;
+}
+} // namespace
+
+GpuTimer::GpuTimer()
+  : is_supported_{ is_timer_query_supported() }
+{
+  if (not is_supported_) {
+    spdlog::info("GpuTimer: timer queries are not supported, GPU stages "
+                 "will not be timed");
+  }
+}
+
+GpuTimer::~GpuTimer()
+{
+  for (auto& queries : frames_) {
+    for (const auto& query : queries) {
+      free_queries_.push_back(query.query_);
+    }
+  }
+  if (not free_queries_.empty()) {
+    gl::glDeleteQueries(static_cast<gl::GLsizei>(free_queries_.size()),
+                        free_queries_.data());
+  }
+}
+
+auto
+GpuTimer::begin(const char* name) -> void
+{
+  if (not is_supported_) {
+    return;
+  }
+  if (is_running_) {
+    end();
+  }
+
+  const auto query = allocate_query();
+  gl::glBeginQuery(gl::GL_TIME_ELAPSED, query);
+  frames_[frame_ % latency_frames].push_back(Query{ name, query });
+  is_running_ = true;
+}
+
+auto
+GpuTimer::end() -> void
+{
+  if (is_running_) {
+    gl::glEndQuery(gl::GL_TIME_ELAPSED);
+    is_running_ = false;
+  }
+}
+
+auto
+GpuTimer::end_frame() -> void
+{
+  if (not is_supported_) {
+    return;
+  }
+  end();
+
+  // Reuse the slot of the oldest frame in flight
+  frame_++;
+  collect(frames_[frame_ % latency_frames]);
+}
+
+auto
+GpuTimer::allocate_query() -> gl::GLuint
+{
+  if (free_queries_.empty()) {
+    gl::GLuint query = 0;
+    gl::glGenQueries(1, &query);
+    return query;
+  }
+  const auto query = free_queries_.back();
+  free_queries_.pop_back();
+  return query;
+}
+
+auto
+GpuTimer::collect(std::vector<Query>& queries) -> void
+{
+  auto& profiler = utils::Profiler::get();
+  for (const auto& query : queries) {
+    gl::GLuint is_available = 0;
+    gl::glGetQueryObjectuiv(
+      query.query_, gl::GL_QUERY_RESULT_AVAILABLE, &is_available);
+    if (is_available) {
+      gl::GLuint64 elapsed = 0;
+      gl::glGetQueryObjectui64v(query.query_, gl::GL_QUERY_RESULT, &elapsed);
+      profiler.record_duration(query.name_, std::chrono::nanoseconds(elapsed));
+    } else {
+      SPDLOG_TRACE("GpuTimer: dropping late result of '{}'", query.name_);
+    }
+    // A pending query can be restarted (its result is discarded)
+    free_queries_.push_back(query.query_);
+  }
+  queries.clear();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <glbinding/gl/gl.h>
+
+namespace render {
+
+/**
+ * @brief GPU time of render stages (via GL_TIME_ELAPSED queries)
+ *
+ * Results are read back `latency_frames` later, when they are (usually)
+ * available, so reading them never stalls the pipeline. Results, that are
+ * still not available by then, are dropped. Finished timings are reported
+ * to `utils::Profiler` (next to CPU zones).
+ *
+ * Without timer queries (GL < 3.3 without ARB_timer_query, or a counter of
+ * zero bits), timing is a no-op.
+ *
+ * @note Timer queries can not nest: a stage must end before the next begins.
+ */
+class GpuTimer
+{
+public:
+  static constexpr std::size_t latency_frames = 3;
+
+  /// @note Requires current GL context
+  GpuTimer();
+  ~GpuTimer();
+
+  GpuTimer(const GpuTimer&) = delete;
+  GpuTimer& operator=(const GpuTimer&) = delete;
+
+  auto is_supported() const -> bool { return is_supported_; }
+
+  /// @brief Start timing stage `name` (a string literal, as profiler zones)
+  auto begin(const char* name) -> void;
+  auto end() -> void;
+
+  /// @brief Report results of past frames & start next frame
+  auto end_frame() -> void;
+
+private:
+  struct Query
+  {
+    const char* name_;
+    gl::GLuint query_;
+  };
+
+  auto allocate_query() -> gl::GLuint;
+  /// @brief Report (available) results of `queries` & recycle them
+  auto collect(std::vector<Query>& queries) -> void;
+
+  bool is_supported_{ false };
+  bool is_running_{ false };
+  std::size_t frame_{ 0 };
+  /// @brief Queries issued per frame (ring of frames in flight)
+  std::array<std::vector<Query>, latency_frames> frames_;
+  std::vector<gl::GLuint> free_queries_;
+};
+
+} // namespace render
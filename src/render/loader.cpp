@@ -1,12 +1,17 @@
 #include <render/loader.hpp>
 
+#include <cassert>
+#include <cstring>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include <FreeImage.h>
 #include <glbinding/gl/gl.h>
 #include <spdlog/spdlog.h>
 
+#include <utils/raii_helpers.hpp>
+
 static struct FreeImageInitializerGuard
 {
   FreeImageInitializerGuard() { FreeImage_Initialise(); }
@@ -15,22 +20,18 @@ static struct FreeImageInitializerGuard
 
 using namespace render;
 
+namespace {
+/// @brief Format detected from content, or guessed from extension of `path`
 auto
-render::load_texture_from_file(const std::filesystem::path& path,
-                               std::optional<utils::Color> alpha_color)
-  -> Texture
-try {
-  spdlog::trace("load_texture_from_file: '{}'", path.c_str());
-  if (not std::filesystem::exists(path)) {
-    throw std::runtime_error(fmt::format("Missing file {}", path.c_str()));
-  }
-
+get_image_format(FREE_IMAGE_FORMAT detected, const std::filesystem::path& path)
+  -> FREE_IMAGE_FORMAT
+{
   // Source:
   // https://stackoverflow.com/questions/19606736/loading-an-image-with-freeimage
 
-  FREE_IMAGE_FORMAT formato = FreeImage_GetFileType(path.c_str(), 0);
-  formato = formato == FIF_UNKNOWN ? FreeImage_GetFIFFromFilename(path.c_str())
-                                   : formato;
+  FREE_IMAGE_FORMAT formato = detected == FIF_UNKNOWN
+                                ? FreeImage_GetFIFFromFilename(path.c_str())
+                                : detected;
   if (formato == FIF_UNKNOWN) {
     if (FreeImage_GetFIFCount() == 0) {
       throw std::runtime_error("Internal error: FreeImage supports 0 formats");
@@ -51,87 +52,155 @@ try {
   }
 
   spdlog::info("Loading format: {}", FreeImage_GetFIFDescription(formato));
+  return formato;
+}
 
-  FIBITMAP* imagen = FreeImage_Load(formato, path.c_str());
-
+/// @brief Take ownership of loaded bitmap
+auto
+make_image_data(FIBITMAP* imagen) -> ImageData
+{
   if (not imagen) {
     throw std::runtime_error("Failed to load image via FreeImage");
   }
 
-  FIBITMAP* temp = imagen;
-  imagen = FreeImage_ConvertTo32Bits(imagen);
+  // Keep 32-bit images as they are, convert the others
+  if (FreeImage_GetBPP(imagen) != 32) {
+    FIBITMAP* temp = imagen;
+    imagen = FreeImage_ConvertTo32Bits(temp);
+    FreeImage_Unload(temp);
+    if (not imagen) {
+      throw std::runtime_error("Failed to convert image to 32 bits");
+    }
+  }
+  auto bitmap = utils::make_raii_deleter<FIBITMAP>(
+    imagen, [](FIBITMAP* bitmap) { FreeImage_Unload(bitmap); });
 
-  const auto width_ = FreeImage_GetWidth(imagen);
-  const auto height_ = FreeImage_GetHeight(imagen);
+  const auto width = FreeImage_GetWidth(imagen);
+  const auto height = FreeImage_GetHeight(imagen);
+  if (width == 0 || height == 0) {
+    throw std::runtime_error("Invalid image: one of dimensions is 0!");
+  }
 
-  char* image_data = (char*)FreeImage_GetBits(imagen);
+  // Rows are stored bottom-up (as OpenGL expects) and are uploaded as they
+  // are, without any per-pixel conversion. Color key is applied in shader.
+  ImageData result;
+  result.width_ = width;
+  result.height_ = height;
+#if FREEIMAGE_COLORORDER == FREEIMAGE_COLORORDER_BGR
+  result.format_ = gl::GL_BGRA;
+#else
+  result.format_ = gl::GL_RGBA;
+#endif
+  result.pixels_ = FreeImage_GetBits(imagen);
+  result.storage_ = std::move(bitmap);
+  return result;
+}
+} // namespace
 
-  if (width_ == 0 || height_ == 0) {
-    throw std::runtime_error("Invalid image: one of dimensions is 0!");
+auto
+render::load_image_from_file(const std::filesystem::path& path) -> ImageData
+try {
+  SPDLOG_TRACE("load_image_from_file: '{}'", path.c_str());
+  if (not std::filesystem::exists(path)) {
+    throw std::runtime_error(fmt::format("Missing file {}", path.c_str()));
   }
 
-  /**
-   * @brief Tigtly-packed RGBA (8-bit per channel)
-   *
-   */
-  union PixelData
-  {
-    gl::GLubyte bytes[4];
-    struct
-    {
-      gl::GLubyte r, g, b, a;
-    };
-  };
-  static_assert(sizeof(PixelData) == 4, "PixelData must be tightly-packed");
-
-  auto texture_data =
-    std::unique_ptr<PixelData[]>{ new PixelData[width_ * height_] };
-
-  PixelData* gl_texture_data = texture_data.get();
-
-  /// Should invert texture's Y row (due to OpenGL's (0,0) being in bottom-down
-  /// corner)
-  bool invert_texture_v_axis = false;
-
-  for (int r = 0; r < height_; r++) {
-    for (int c = 0; c < width_; c++) {
-
-      const auto row = invert_texture_v_axis ? height_ - r - 1 : r;
-      const auto j_out = row * width_ + c;
-      const auto j_in = r * width_ + c;
-
-      // Assumes data stored as BGRA?
-      gl_texture_data[j_out].r = image_data[j_in * 4 + 2];
-      gl_texture_data[j_out].g = image_data[j_in * 4 + 1];
-      gl_texture_data[j_out].b = image_data[j_in * 4 + 0];
-      gl_texture_data[j_out].a = image_data[j_in * 4 + 3];
-
-      if (alpha_color) {
-        const auto& color = *alpha_color;
-        auto& pixel = gl_texture_data[j_out];
-        if (utils::Color(pixel.r, pixel.g, pixel.b) == color) {
-          pixel.a = 0;
-        }
+  const auto format =
+    get_image_format(FreeImage_GetFileType(path.c_str(), 0), path);
+  return make_image_data(FreeImage_Load(format, path.c_str()));
+} catch (const std::exception& e) {
+  throw std::runtime_error(fmt::format("{}: {}", path.c_str(), e.what()));
+}
+
+auto
+render::load_image_from_memory(std::string_view content,
+                               const std::filesystem::path& path) -> ImageData
+try {
+  SPDLOG_TRACE("load_image_from_memory: '{}'", path.c_str());
+  // Memory is only read from, despite the non-const parameter
+  auto* data = reinterpret_cast<BYTE*>(const_cast<char*>(content.data()));
+  const auto memory = utils::make_raii_deleter<FIMEMORY>(
+    FreeImage_OpenMemory(data, static_cast<DWORD>(content.size())),
+    [](FIMEMORY* memory) { FreeImage_CloseMemory(memory); });
+
+  const auto format =
+    get_image_format(FreeImage_GetFileTypeFromMemory(memory.get(), 0), path);
+  // Decoded bitmap doesn't refer to the memory
+  return make_image_data(FreeImage_LoadFromMemory(format, memory.get()));
+} catch (const std::exception& e) {
+  throw std::runtime_error(fmt::format("{}: {}", path.c_str(), e.what()));
+}
+
+auto
+render::palettize_image(const ImageData& image) -> std::optional<ImageData>
+{
+  if (image.is_palettized()) {
+    return image;
+  }
+
+  const auto pixel_count = std::size_t{ image.width_ } * image.height_;
+  auto storage = std::make_shared<std::vector<gl::GLubyte>>(
+    ImageData::palette_size * 4 + pixel_count);
+  auto* palette = storage->data();
+  auto* indices = palette + ImageData::palette_size * 4;
+
+  // 32-bit rows are 4-byte aligned, hence the pixels are contiguous
+  std::unordered_map<std::uint32_t, gl::GLubyte> color_indices;
+  for (std::size_t i = 0; i < pixel_count; i++) {
+    std::uint32_t color;
+    std::memcpy(&color, image.pixels_ + i * 4, sizeof(color));
+
+    auto iterator = color_indices.find(color);
+    if (iterator == color_indices.end()) {
+      if (color_indices.size() == ImageData::palette_size) {
+        return std::nullopt;
+      }
+      const auto index = static_cast<gl::GLubyte>(color_indices.size());
+      iterator = color_indices.emplace(color, index).first;
+
+      // Palette is always RGBA
+      auto* entry = palette + std::size_t{ index } * 4;
+      std::memcpy(entry, &color, sizeof(color));
+      if (image.format_ == gl::GL_BGRA) {
+        std::swap(entry[0], entry[2]);
       }
     }
+    indices[i] = iterator->second;
   }
 
-  FreeImage_Unload(temp);
-  FreeImage_Unload(imagen);
+  ImageData result;
+  result.width_ = image.width_;
+  result.height_ = image.height_;
+  result.format_ = gl::GL_RED;
+  result.pixels_ = indices;
+  result.palette_ = palette;
+  result.storage_ = std::move(storage);
+  return result;
+}
 
+namespace {
+auto
+create_nearest_texture(gl::GLenum internal_format,
+                       unsigned width,
+                       unsigned height,
+                       gl::GLenum format,
+                       const gl::GLubyte* pixels) -> Texture
+{
   auto result = create_texture();
   gl::GLuint tex = result;
 
   gl::glBindTexture(gl::GL_TEXTURE_2D, tex);
+  // Indices of palettized images are tightly packed
+  gl::glPixelStorei(gl::GL_UNPACK_ALIGNMENT, format == gl::GL_RED ? 1 : 4);
   gl::glTexImage2D(gl::GL_TEXTURE_2D,
                    0,
-                   gl::GL_RGBA,
-                   width_,
-                   height_,
+                   internal_format,
+                   width,
+                   height,
                    0,
-                   gl::GL_RGBA,
+                   format,
                    gl::GL_UNSIGNED_BYTE,
-                   (gl::GLvoid*)gl_texture_data);
+                   pixels);
 
   gl::glTexParameteri(
     gl::GL_TEXTURE_2D, gl::GL_TEXTURE_WRAP_S, gl::GL_CLAMP_TO_EDGE);
@@ -143,6 +212,32 @@ try {
     gl::GL_TEXTURE_2D, gl::GL_TEXTURE_MAG_FILTER, gl::GL_NEAREST);
 
   return result;
-} catch (const std::exception& e) {
-  throw std::runtime_error(fmt::format("{}: {}", path.c_str(), e.what()));
-}
\ No newline at end of file
+}
+} // namespace
+
+auto
+render::upload_texture(const ImageData& image) -> Texture
+{
+  return create_nearest_texture(image.is_palettized() ? gl::GL_R8 : gl::GL_RGBA8,
+                                image.width_,
+                                image.height_,
+                                image.format_,
+                                image.pixels_);
+}
+
+auto
+render::upload_palette(const ImageData& image) -> Texture
+{
+  assert(image.is_palettized());
+  return create_nearest_texture(gl::GL_RGBA8,
+                                ImageData::palette_size,
+                                1,
+                                gl::GL_RGBA,
+                                image.palette_);
+}
+
+auto
+render::load_texture_from_file(const std::filesystem::path& path) -> Texture
+{
+  return upload_texture(load_image_from_file(path));
+}
@@ -1,15 +1,73 @@
 #pragma once
 
 #include <filesystem>
+#include <cstddef>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include <render/resource.hpp>
-#include <utils/color.hpp>
 
 namespace render {
+
+/**
+ * @brief Decoded image, ready to be uploaded as it is
+ *
+ * Pixels are 8-bit per channel in `format_` (BGRA on little-endian machines),
+ * rows are stored bottom-up and 4-byte aligned.
+ *
+ * Palettized images (`format_` is GL_RED) store one 8-bit index per pixel
+ * (rows tightly packed) into `palette_` of RGBA colors instead.
+ */
+struct ImageData
+{
+  static constexpr std::size_t palette_size = 256;
+
+  unsigned width_{ 0 };
+  unsigned height_{ 0 };
+  gl::GLenum format_{ gl::GL_RGBA };
+  const gl::GLubyte* pixels_{ nullptr };
+  /// @brief Palette (`palette_size` RGBA colors) of palettized images
+  const gl::GLubyte* palette_{ nullptr };
+  /// @brief Owner of `pixels_` & `palette_` (e.g. decoder's bitmap)
+  std::shared_ptr<void> storage_;
+
+  auto is_palettized() const -> bool { return format_ == gl::GL_RED; }
+
+  /// @brief Size of `pixels_` in bytes
+  auto get_pixels_size() const -> std::size_t
+  {
+    return std::size_t{ width_ } * height_ * (is_palettized() ? 1 : 4);
+  }
+};
+
+/// @brief Decode image on CPU
+/// @note Does not touch OpenGL, hence can be called from any thread
+auto
+load_image_from_file(const std::filesystem::path& path) -> ImageData;
+
+/// @brief Decode image from already read `content` of file `path`
+/// @note Does not touch OpenGL, hence can be called from any thread
+auto
+load_image_from_memory(std::string_view content,
+                       const std::filesystem::path& path) -> ImageData;
+
+/// @brief Convert image to palettized form
+/// @return nullopt when the image has more colors than fit the palette
+auto
+palettize_image(const ImageData& image) -> std::optional<ImageData>;
+
+/// @brief Upload decoded image into a new texture (requires GL context)
+/// @note Palettized images are uploaded as indices only (see upload_palette)
+auto
+upload_texture(const ImageData& image) -> Texture;
+
+/// @brief Upload palette of palettized image as `palette_size`x1 texture
+auto
+upload_palette(const ImageData& image) -> Texture;
+
 auto
-load_texture_from_file(const std::filesystem::path& path,
-                       std::optional<utils::Color> alpha_color) -> Texture;
+load_texture_from_file(const std::filesystem::path& path) -> Texture;
 
 } // namespace render
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include <render/render_queue.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <tuple>
+
+#include <render/gpu_timer.hpp>
+#include <utils/profiler.hpp>
+
+using namespace render;
+
+auto
+RenderQueue::set_gpu_timer(GpuTimer* timer,
+                           std::vector<const char*> layer_names) -> void
+{
+  gpu_timer_ = timer;
+  layer_names_ = std::move(layer_names);
+}
+
+auto
+RenderQueue::submit() -> void
+{
+  PROFILE_ZONE("render queue submit");
+  statistics_ = Statistics{};
+
+  // I. Order by state key, keeping push order for equal keys
+  order_.resize(commands_.size());
+  std::iota(order_.begin(), order_.end(), 0);
+  std::sort(order_.begin(), order_.end(), [this](auto a, auto b) {
+    const auto& x = commands_[a];
+    const auto& y = commands_[b];
+    return std::tie(x.layer_, x.state_.program_, x.state_.texture_, a) <
+           std::tie(y.layer_, y.state_.program_, y.state_.texture_, b);
+  });
+
+  // II. Execute, binding only the state that differs
+  std::optional<RenderState> bound;
+  std::optional<unsigned> timed_layer;
+  for (const auto index : order_) {
+    const auto& command = commands_[index];
+    const auto& state = command.state_;
+
+    if (gpu_timer_ and timed_layer != command.layer_) {
+      timed_layer = command.layer_;
+      if (command.layer_ < layer_names_.size() and
+          layer_names_[command.layer_]) {
+        gpu_timer_->begin(layer_names_[command.layer_]);
+      } else {
+        gpu_timer_->end();
+      }
+    }
+
+    if (not bound or bound->program_ != state.program_) {
+      gl::glUseProgram(state.program_);
+      statistics_.program_binds_++;
+    }
+
+    if (not bound or bound->texture_ != state.texture_) {
+      gl::glActiveTexture(gl::GL_TEXTURE0);
+      gl::glBindTexture(gl::GL_TEXTURE_2D, state.texture_);
+      statistics_.texture_binds_++;
+    }
+
+    if (not bound or bound->blend_ != state.blend_) {
+      if (state.blend_) {
+        gl::glEnable(gl::GL_BLEND);
+        gl::glBlendFunc(gl::GL_SRC_ALPHA, gl::GL_ONE_MINUS_SRC_ALPHA);
+      } else {
+        gl::glDisable(gl::GL_BLEND);
+      }
+      statistics_.blend_changes_++;
+    }
+
+    bound = state;
+    command.invoke_(command.draw_);
+    statistics_.draws_++;
+  }
+
+  if (gpu_timer_) {
+    gpu_timer_->end();
+  }
+
+  // III. Leave default state behind for code outside of the queue
+  if (bound) {
+    gl::glUseProgram(0);
+    gl::glBindTexture(gl::GL_TEXTURE_2D, 0);
+    gl::glDisable(gl::GL_BLEND);
+  }
+
+  draws_total_.increment(statistics_.draws_);
+  texture_binds_total_.increment(statistics_.texture_binds_);
+  program_binds_total_.increment(statistics_.program_binds_);
+  commands_.clear();
+  staged_.clear();
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include <glbinding/gl/gl.h>
+
+#include <utils/metrics.hpp>
+
+namespace render {
+
+// Fwd
+class GpuTimer;
+
+/// @brief OpenGL state, a draw call depends on
+struct RenderState
+{
+  gl::GLuint program_{ 0 };
+  /// @brief Texture, bound to unit 0
+  gl::GLuint texture_{ 0 };
+  /// @brief Alpha blending (SRC_ALPHA, ONE_MINUS_SRC_ALPHA)
+  bool blend_{ false };
+};
+
+/**
+ * @brief Retained list of draw calls, submitted once per frame
+ *
+ * Renderers push commands instead of drawing immediately. On submit, commands
+ * are ordered by (layer, program, texture), so that state is bound only when
+ * it changes. Commands with equal keys keep their push order.
+ *
+ * Pushing doesn't allocate (once vectors have grown in the first frames):
+ * draw callables are stored inline in commands and bulk data of draws is
+ * staged into an arena, both reused between frames.
+ */
+class RenderQueue
+{
+public:
+  /// @brief Size of a draw callable (its captures) at most
+  static constexpr std::size_t draw_capacity = 96;
+
+  /// @brief Counters of a single submit
+  struct Statistics
+  {
+    unsigned draws_{ 0 };
+    unsigned program_binds_{ 0 };
+    unsigned texture_binds_{ 0 };
+    unsigned blend_changes_{ 0 };
+
+    auto get_state_changes() const -> unsigned
+    {
+      return program_binds_ + texture_binds_ + blend_changes_;
+    }
+  };
+
+  /// @brief Set layer of subsequent commands (lower layers are drawn first)
+  auto set_layer(unsigned layer) -> void { layer_ = layer; }
+  auto get_layer() const -> unsigned { return layer_; }
+
+  /**
+   * @brief Queue a draw call
+   *
+   * @param draw Issues the draw call itself (with `state` already bound). It
+   * is copied into the command, hence it must be trivially copyable (e.g. a
+   * lambda, capturing pointers and plain values) and fit `draw_capacity`.
+   */
+  template<typename Draw>
+  auto push(const RenderState& state, const Draw& draw) -> void
+  {
+    static_assert(std::is_trivially_copyable_v<Draw>,
+                  "RenderQueue: draw must be trivially copyable");
+    static_assert(sizeof(Draw) <= draw_capacity and
+                    alignof(Draw) <= alignof(std::max_align_t),
+                  "RenderQueue: draw doesn't fit into command");
+
+    auto& command = commands_.emplace_back();
+    command.layer_ = layer_;
+    command.state_ = state;
+    command.invoke_ = [](const void* stored) {
+      (*static_cast<const Draw*>(stored))();
+    };
+    new (command.draw_) Draw(draw);
+  }
+
+  /**
+   * @brief Copy draw's bulk data (e.g. vertices) into the frame's arena
+   *
+   * @return Offset of data, valid until the end of submit
+   */
+  template<typename T>
+  auto stage(const std::vector<T>& data) -> std::size_t
+  {
+    static_assert(std::is_trivially_copyable_v<T> and
+                  alignof(T) <= alignof(std::max_align_t));
+    constexpr auto alignment = alignof(std::max_align_t);
+    const auto offset =
+      (staged_.size() + alignment - 1) / alignment * alignment;
+    staged_.resize(offset + data.size() * sizeof(T));
+    std::memcpy(staged_.data() + offset, data.data(), data.size() * sizeof(T));
+    return offset;
+  }
+
+  /// @brief Data, staged at `offset` (during submit)
+  template<typename T>
+  auto get_staged(std::size_t offset) const -> const T*
+  {
+    return reinterpret_cast<const T*>(staged_.data() + offset);
+  }
+
+  /// @brief Sort & execute queued commands, then clear the queue
+  auto submit() -> void;
+
+  /// @brief Statistics of the last submit
+  auto get_statistics() const -> const Statistics& { return statistics_; }
+
+  /// @brief Time layers on GPU during submit (nullptr disables timing)
+  /// @param layer_names Stage name per layer (layers without are not timed)
+  auto set_gpu_timer(GpuTimer* timer, std::vector<const char*> layer_names)
+    -> void;
+
+private:
+  struct Command
+  {
+    unsigned layer_;
+    RenderState state_;
+    /// @brief Calls draw callable, stored in `draw_`
+    void (*invoke_)(const void* draw);
+    alignas(std::max_align_t) std::byte draw_[draw_capacity];
+  };
+
+  /// @brief Queued commands (cleared by submit, capacity is kept)
+  std::vector<Command> commands_;
+  /// @brief Arena of staged data (cleared by submit, capacity is kept)
+  std::vector<std::byte> staged_;
+  /// @brief Submit order (indices to `commands_`, reused between frames)
+  std::vector<std::size_t> order_;
+  unsigned layer_{ 0 };
+  Statistics statistics_;
+
+  /// @brief Totals of `statistics_` over all frames
+  utils::Counter draws_total_{ "render_draws_total" };
+  utils::Counter texture_binds_total_{ "render_texture_binds_total" };
+  utils::Counter program_binds_total_{ "render_program_binds_total" };
+
+  GpuTimer* gpu_timer_{ nullptr };
+  std::vector<const char*> layer_names_;
+};
+
+} // namespace render
@@ -0,0 +1,150 @@
+#include <render/stream_buffer.hpp>
+
+#include <cstring>
+
+#include <glbinding-aux/ContextInfo.h>
+#include <glbinding/Version.h>
+#include <glbinding/gl/extension.h>
+#include <spdlog/spdlog.h>
+
+#include <utils/exceptions.hpp>
+#include <utils/opengl.hpp>
+
+using namespace render;
+
+namespace {
+/// @brief Max. time to block in a single glClientWaitSync call (in ns)
+constexpr gl::GLuint64 fence_wait_timeout = 1'000'000;
+
+auto
+is_buffer_storage_supported() -> bool
+{
+  return glbinding::aux::ContextInfo::version() >= glbinding::Version(4, 4) or
+         glbinding::aux::ContextInfo::supported(
+           { gl::GLextension::GL_ARB_buffer_storage });
+}
+
+auto
+align_up(gl::GLsizeiptr value) -> gl::GLsizeiptr
+{
+  return (value + StreamBuffer::alignment - 1) / StreamBuffer::alignment *
+         StreamBuffer::alignment;
+}
+} // namespace
+
+StreamBuffer::StreamBuffer(gl::GLsizeiptr region_size, unsigned region_count)
+  : buffer_{ create_buffer() }
+  , region_size_{ align_up(region_size) }
+  , region_count_{ region_count }
+  , fences_(region_count, nullptr)
+{
+  utils::throw_runtime_on_false(region_count_ > 0,
+                                "StreamBuffer needs at least one region");
+
+  const auto total_size = region_size_ * region_count_;
+  gl::glBindBuffer(gl::GL_ARRAY_BUFFER, buffer_);
+  if (is_buffer_storage_supported()) {
+    const auto flags =
+      gl::GL_MAP_WRITE_BIT | gl::GL_MAP_PERSISTENT_BIT | gl::GL_MAP_COHERENT_BIT;
+    gl::glBufferStorage(gl::GL_ARRAY_BUFFER, total_size, nullptr, flags);
+    persistent_mapping_ = static_cast<std::byte*>(
+      gl::glMapBufferRange(gl::GL_ARRAY_BUFFER, 0, total_size, flags));
+  }
+
+  if (not persistent_mapping_) {
+    SPDLOG_DEBUG("StreamBuffer: persistent mapping not available, "
+                 "falling back to glMapBufferRange");
+    gl::glBufferData(
+      gl::GL_ARRAY_BUFFER, total_size, nullptr, gl::GL_STREAM_DRAW);
+  }
+  gl::glBindBuffer(gl::GL_ARRAY_BUFFER, 0);
+  utils::throw_on_opengl_error("Failed to create StreamBuffer");
+}
+
+StreamBuffer::~StreamBuffer()
+{
+  for (auto& fence : fences_) {
+    if (fence) {
+      gl::glDeleteSync(fence);
+    }
+  }
+
+  if (persistent_mapping_) {
+    gl::glBindBuffer(gl::GL_ARRAY_BUFFER, buffer_);
+    gl::glUnmapBuffer(gl::GL_ARRAY_BUFFER);
+    gl::glBindBuffer(gl::GL_ARRAY_BUFFER, 0);
+  }
+}
+
+auto
+StreamBuffer::upload(const void* data, gl::GLsizeiptr size) -> gl::GLintptr
+{
+  utils::throw_runtime_on_false(
+    size <= region_size_,
+    fmt::format("StreamBuffer: upload of {} bytes exceeds region size {}",
+                size,
+                region_size_));
+
+  if (region_offset_ + size > region_size_) {
+    next_region();
+  }
+
+  const auto offset = current_region_ * region_size_ + region_offset_;
+  if (persistent_mapping_) {
+    std::memcpy(persistent_mapping_ + offset, data, size);
+  } else {
+    gl::glBindBuffer(gl::GL_ARRAY_BUFFER, buffer_);
+    auto* destination = gl::glMapBufferRange(gl::GL_ARRAY_BUFFER,
+                                             offset,
+                                             size,
+                                             gl::GL_MAP_WRITE_BIT |
+                                               gl::GL_MAP_UNSYNCHRONIZED_BIT |
+                                               gl::GL_MAP_INVALIDATE_RANGE_BIT);
+    utils::throw_runtime_on_false(destination != nullptr,
+                                  "StreamBuffer: failed to map buffer range");
+    std::memcpy(destination, data, size);
+    gl::glUnmapBuffer(gl::GL_ARRAY_BUFFER);
+    gl::glBindBuffer(gl::GL_ARRAY_BUFFER, 0);
+  }
+
+  region_offset_ = align_up(region_offset_ + size);
+  return offset;
+}
+
+auto
+StreamBuffer::next_region() -> void
+{
+  auto& fence = fences_[current_region_];
+  if (fence) {
+    gl::glDeleteSync(fence);
+  }
+  fence = gl::glFenceSync(gl::GL_SYNC_GPU_COMMANDS_COMPLETE, gl::GL_NONE_BIT);
+
+  current_region_ = (current_region_ + 1) % region_count_;
+  region_offset_ = 0;
+  wait_for_region(current_region_);
+}
+
+auto
+StreamBuffer::wait_for_region(unsigned region) -> void
+{
+  auto& fence = fences_[region];
+  if (not fence) {
+    return;
+  }
+
+  while (true) {
+    const auto result = gl::glClientWaitSync(
+      fence, gl::GL_SYNC_FLUSH_COMMANDS_BIT, fence_wait_timeout);
+    if (result == gl::GL_ALREADY_SIGNALED or
+        result == gl::GL_CONDITION_SATISFIED) {
+      break;
+    }
+    if (result == gl::GL_WAIT_FAILED) {
+      spdlog::error("StreamBuffer: glClientWaitSync failed");
+      break;
+    }
+  }
+  gl::glDeleteSync(fence);
+  fence = nullptr;
+}
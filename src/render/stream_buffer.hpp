@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glbinding/gl/gl.h>
+
+#include <render/resource.hpp>
+
+namespace render {
+
+/**
+ * @brief Vertex buffer for geometry, re-uploaded every frame
+ *
+ * The buffer is a ring of `region_count` regions. Uploads are appended into
+ * the current region; once it is full, the region is fenced and the writer
+ * moves to the next one, waiting until the GPU is done with it. Hence the
+ * driver never has to orphan or re-allocate storage.
+ *
+ * With GL 4.4 (or ARB_buffer_storage), the buffer is mapped persistently
+ * once. Otherwise, each upload maps its range with `glMapBufferRange`
+ * (unsynchronized, as the fences already guard the regions).
+ */
+class StreamBuffer
+{
+public:
+  /// @brief Offsets of uploaded data are aligned to this (in bytes)
+  static constexpr gl::GLsizeiptr alignment = 16;
+
+  StreamBuffer() = default;
+  explicit StreamBuffer(gl::GLsizeiptr region_size, unsigned region_count = 3);
+  ~StreamBuffer();
+
+  StreamBuffer(const StreamBuffer&) = delete;
+  StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+  /**
+   * @brief Copy `size` bytes into buffer
+   *
+   * @return Offset of data in buffer (in bytes)
+   */
+  auto upload(const void* data, gl::GLsizeiptr size) -> gl::GLintptr;
+
+  template<typename T>
+  auto upload(const std::vector<T>& data) -> gl::GLintptr
+  {
+    return upload(data.data(), data.size() * sizeof(T));
+  }
+
+  auto get_buffer() const -> const Buffer& { return buffer_; }
+  auto is_persistent() const -> bool { return persistent_mapping_; }
+
+private:
+  /// @brief Fence the current region and move to the next one
+  auto next_region() -> void;
+  auto wait_for_region(unsigned region) -> void;
+
+  Buffer buffer_;
+  gl::GLsizeiptr region_size_{ 0 };
+  unsigned region_count_{ 0 };
+
+  unsigned current_region_{ 0 };
+  /// @brief Write cursor, relative to the current region
+  gl::GLsizeiptr region_offset_{ 0 };
+
+  /// @brief Fences of regions, the GPU may still read from (or nullptr)
+  std::vector<gl::GLsync> fences_;
+  /// @brief Whole buffer mapped (only when persistent mapping is supported)
+  std::byte* persistent_mapping_{ nullptr };
+};
+
+} // namespace render
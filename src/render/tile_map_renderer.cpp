@@ -13,9 +13,13 @@ TileMapRenderer::render(const TiledMap& map) -> void
 {
   renderer_.bind_tileset(*map.tileset_);
 
-  const auto tile_size = get_tile_size(map);
-  const auto tile_width = tile_size[0];
-  const auto tile_height = tile_size[1];
+  // Cull tiles outside of camera's view
+  const auto visible_area = renderer_.get_viewport().get_visible_area();
+  const auto map_size = glm::vec2(map.count_x, map.count_y);
+  const auto first_tile = glm::clamp(
+    glm::floor(visible_area.get_top_left()), glm::vec2(0), map_size);
+  const auto last_tile = glm::clamp(
+    glm::ceil(visible_area.get_bottom_right()), glm::vec2(0), map_size);
 
   for (const auto& layer : map.layers_) {
     if (not layer.visible_ or
@@ -25,32 +29,19 @@ TileMapRenderer::render(const TiledMap& map) -> void
 
     const auto& data = std::get<TiledMap::TileLayer>(layer.data_);
 
-    for (size_t y = 0; y < map.count_y; y++) {
-      for (size_t x = 0; x < map.count_x; x++) {
+    for (size_t y = first_tile.y; y < last_tile.y; y++) {
+      for (size_t x = first_tile.x; x < last_tile.x; x++) {
         // Map (x,y) to <0, width*height)
         const auto tile_position_index = y * map.count_x + x;
         const auto tile_texture_index =
           data.tile_indices_.at(tile_position_index);
 
-        const auto start_x = tile_width * x;
-        const auto start_y = tile_height * y;
+        if (tile_texture_index == TiledMap::invalid_index) {
+          continue;
+        }
 
-        renderer_.draw_quad(start_x,
-                            start_y,
-                            start_x + tile_width,
-                            start_y + tile_height,
-                            tile_texture_index);
+        renderer_.draw_quad(x, y, x + 1, y + 1, tile_texture_index);
       }
     }
   }
 }
-
-auto
-TileMapRenderer::get_tile_size(const TiledMap& map) -> glm::vec2
-{
-  const auto screen_size = renderer_.get_viewport().get_size();
-
-  const auto tile_width = screen_size[0] / map.count_x;
-  const auto tile_height = screen_size[1] / map.count_y;
-  return glm::vec2(tile_width, tile_height);
-}
\ No newline at end of file
@@ -7,8 +7,8 @@ public:
   TileMapRenderer() = delete;
   explicit TileMapRenderer(TileRenderer& renderer);
 
+  /// @brief Render tiles, visible by viewport's camera (in world units)
   auto render(const TiledMap& map) -> void;
-  auto get_tile_size(const TiledMap& map) -> glm::vec2;
 
 private:
   TileRenderer& renderer_;
@@ -17,15 +17,6 @@ allocate_opengl_string(unsigned length) -> std::vector<gl::GLchar>
   return std::vector<gl::GLchar>(length + 1);
 }
 
-auto
-convert_string_to_gl_string(const std::string& str)
-{
-  const auto result_length = str.length() + 1;
-  std::vector<gl::GLchar> result(result_length);
-  std::memcpy(result.data(), str.data(), result_length);
-  return result;
-}
-
 auto
 convert_gl_string_to_printable_string(gl::GLchar const* str) -> std::string
 {
@@ -49,14 +40,15 @@ exception_assert(T expr, const std::string& msg) -> void
 } // namespace
 
 auto
-render::load_shader(gl::GLenum type, const std::string& code) -> Shader
+render::load_shader(gl::GLenum type, std::string_view code) -> Shader
 {
   utils::clear_opengl_error();
 
   auto shader = render::create_shader(type);
-  auto converted_code = convert_string_to_gl_string(code);
-  const std::array<const gl::GLchar*, 1> codes = { converted_code.data() };
-  const std::array<const gl::GLint, 1> lengths = { converted_code.size() };
+  // Explicit length, hence the code does not need to be NULL-terminated
+  const std::array<const gl::GLchar*, 1> codes = { code.data() };
+  const std::array<const gl::GLint, 1> lengths = { static_cast<gl::GLint>(
+    code.size()) };
 
   gl::glShaderSource(shader, 1, codes.data(), lengths.data());
   utils::throw_on_opengl_error("Failed to load shader's resource");
@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <memory>
 #include <spdlog/spdlog.h>
+#include <string_view>
 #include <vector>
 
 #include <FreeImage.h>
@@ -15,7 +16,7 @@
 
 namespace render {
 auto
-load_shader(gl::GLenum type, const std::string& code) -> Shader;
+load_shader(gl::GLenum type, std::string_view code) -> Shader;
 
 auto
 link_program(const std::vector<Shader>& shaders) -> Program;
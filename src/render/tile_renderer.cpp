@@ -7,11 +7,44 @@
 
 using namespace render;
 
-render::TileRenderer::TileRenderer(const Viewport& viewport, Program&& program)
-  : viewport_{ viewport }
-  , program_{ std::move(program) }
+render::TileRenderer::TileRenderer(const Viewport& viewport,
+                                   RenderQueue& queue,
+                                   Program&& program)
+  : program_{ std::move(program) }
+  , viewport_{ viewport }
+  , queue_{ queue }
 {
+  query_uniform_locations();
+}
+
+auto
+render::TileRenderer::set_program(Program&& program) -> void
+{
+  program_ = std::move(program);
+  query_uniform_locations();
+  // Uniforms of the new program are all unset
+  tileset_uniforms_ = TilesetUniforms{};
+}
+
+auto
+render::TileRenderer::query_uniform_locations() -> void
+{
+  uniforms_.projection = gl::glGetUniformLocation(program_, "projection");
+  uniforms_.tile_texture = gl::glGetUniformLocation(program_, "tile_texture");
+  uniforms_.tile_count_x = gl::glGetUniformLocation(program_, "tile_count_x");
+  uniforms_.tile_count_y = gl::glGetUniformLocation(program_, "tile_count_y");
+  uniforms_.has_color_key = gl::glGetUniformLocation(program_, "has_color_key");
+  uniforms_.color_key = gl::glGetUniformLocation(program_, "color_key");
+  uniforms_.is_palettized = gl::glGetUniformLocation(program_, "is_palettized");
+  uniforms_.palette_texture =
+    gl::glGetUniformLocation(program_, "palette_texture");
+  uniforms_.tile_id = gl::glGetUniformLocation(program_, "tile_id");
+  uniforms_.quad = gl::glGetUniformLocation(program_, "quad");
+
   gl::glUseProgram(program_);
+  gl::glUniform1i(uniforms_.tile_texture, 0);
+  gl::glUniform1i(uniforms_.palette_texture, 1);
+  gl::glUseProgram(0);
 }
 
 auto
@@ -20,12 +53,11 @@ render::TileRenderer::set_projection_matrix(float min_x,
                                             float max_x,
                                             float max_y) -> void
 {
-  gl::glUseProgram(program_);
   auto matrix = glm::ortho(min_x, max_x, min_y, max_y);
-  {
-    auto location = gl::glGetUniformLocation(program_, "projection");
-    gl::glUniformMatrix4fv(location, 1, gl::GL_FALSE, glm::value_ptr(matrix));
-  }
+  gl::glUseProgram(program_);
+  gl::glUniformMatrix4fv(
+    uniforms_.projection, 1, gl::GL_FALSE, glm::value_ptr(matrix));
+  gl::glUseProgram(0);
 }
 
 auto
@@ -37,26 +69,9 @@ render::TileRenderer::get_viewport() const -> const Viewport&
 auto
 render::TileRenderer::bind_tileset(const Tileset& tileset) -> void
 {
-  gl::glActiveTexture(gl::GL_TEXTURE0);
-  gl::glBindTexture(gl::GL_TEXTURE_2D, tileset.texture_);
-  gl::glUseProgram(program_);
-
-  {
-    auto location = gl::glGetUniformLocation(program_, "tile_texture");
-    gl::glUniform1i(location, 0);
-  }
-
-  {
-    assert(tileset.tile_size_x_);
-    auto location = gl::glGetUniformLocation(program_, "tile_count_x");
-    gl::glUniform1ui(location, tileset.tile_size_x_);
-  }
-
-  {
-    assert(tileset.tile_size_y_);
-    auto location = gl::glGetUniformLocation(program_, "tile_count_y");
-    gl::glUniform1ui(location, tileset.tile_size_y_);
-  }
+  assert(tileset.tile_size_x_);
+  assert(tileset.tile_size_y_);
+  tileset_ = &tileset;
 }
 
 auto
@@ -66,21 +81,45 @@ render::TileRenderer::draw_quad(float x1,
                                 float y2,
                                 unsigned tile_index) -> void
 {
-  {
-    auto location = gl::glGetUniformLocation(program_, "tile_id");
-    gl::glUniform1ui(location, tile_index);
+  assert(tileset_);
+  const auto state = RenderState{ program_, *tileset_->texture_, true };
+  auto tileset_uniforms = TilesetUniforms{};
+  tileset_uniforms.tile_count =
+    glm::uvec2(tileset_->tile_size_x_, tileset_->tile_size_y_);
+  if (const auto& color = tileset_->transparent_color_) {
+    tileset_uniforms.color_key =
+      glm::vec4(color->r, color->g, color->b, 255) / glm::vec4(255);
   }
-
-  {
-    // auto matrix = glm::scale(glm::vec3(x2 - x1, y2 - y1, 1.0)) *
-    // glm::translate(glm::vec3((x1 + x2) / -2.0, (y1 + y2) / -2.0, 0));
-    auto quad = glm::vec4{ x1, y1, x2, y2 };
-    auto location = gl::glGetUniformLocation(program_, "quad");
-    gl::glUniform4fv(location, 1, glm::value_ptr(quad));
+  if (tileset_->palette_) {
+    tileset_uniforms.palette = *tileset_->palette_;
   }
-
-  gl::glUseProgram(program_);
-  quad_.draw();
+  const auto quad = glm::vec4{ x1, y1, x2, y2 };
+
+  queue_.push(state, [this, tileset_uniforms, quad, tile_index]() {
+    // Tileset's uniforms only change with texture (commands are sorted by it)
+    if (tileset_uniforms_ != tileset_uniforms) {
+      const auto& uniforms = tileset_uniforms;
+      gl::glUniform1ui(uniforms_.tile_count_x, uniforms.tile_count.x);
+      gl::glUniform1ui(uniforms_.tile_count_y, uniforms.tile_count.y);
+      gl::glUniform1i(uniforms_.has_color_key, uniforms.color_key.w > 0);
+      gl::glUniform3f(uniforms_.color_key,
+                      uniforms.color_key.x,
+                      uniforms.color_key.y,
+                      uniforms.color_key.z);
+      gl::glUniform1i(uniforms_.is_palettized, uniforms.palette != 0);
+      if (uniforms.palette != 0) {
+        // Queue binds tile textures to unit 0, palettes live in unit 1
+        gl::glActiveTexture(gl::GL_TEXTURE1);
+        gl::glBindTexture(gl::GL_TEXTURE_2D, uniforms.palette);
+        gl::glActiveTexture(gl::GL_TEXTURE0);
+      }
+      tileset_uniforms_ = tileset_uniforms;
+    }
+
+    gl::glUniform1ui(uniforms_.tile_id, tile_index);
+    gl::glUniform4fv(uniforms_.quad, 1, glm::value_ptr(quad));
+    quad_.draw();
+  });
 }
 auto
 render::TileRenderer::draw_quad(const glm::vec2& position,
@@ -7,6 +7,7 @@
 #include <glbinding/gl/gl.h>
 #include <glm/glm.hpp>
 
+#include <render/render_queue.hpp>
 #include <render/tile_program.hpp>
 #include <render/tiled_map.hpp>
 #include <render/tileset.hpp>
@@ -16,12 +17,15 @@ namespace render {
 /**
  * @brief Renders a tile world
  *
+ * Quads are not drawn immediately, but pushed as commands into `RenderQueue`.
  */
 class TileRenderer
 {
 public:
-  TileRenderer(const Viewport& viewport, Program&& program);
+  TileRenderer(const Viewport& viewport, RenderQueue& queue, Program&& program);
 
+  /// @brief Select tileset for subsequent `draw_quad` calls
+  /// @note `tileset` must outlive submit of the queue
   auto bind_tileset(const Tileset& tileset) -> void;
   auto draw_quad(float x1, float y1, float x2, float y2, unsigned tile_index)
     -> void;
@@ -34,7 +38,12 @@ public:
 
   auto get_viewport() const -> const Viewport&;
 
+  /// @brief Replace shader program (e.g. when reloaded)
+  auto set_program(Program&& program) -> void;
+
 private:
+  auto query_uniform_locations() -> void;
+
   struct TileVertex
   {
     float x, y, z;
@@ -63,13 +72,42 @@ private:
 
   } quad_;
 
-  // TODO: camera
-  // TODO: world definition
-
-  unsigned screen_width;
-  unsigned screen_height;
-
   Program program_;
   const Viewport& viewport_;
+  RenderQueue& queue_;
+
+  struct UniformLocations
+  {
+    gl::GLint projection;
+    gl::GLint tile_texture;
+    gl::GLint tile_count_x;
+    gl::GLint tile_count_y;
+    gl::GLint has_color_key;
+    gl::GLint color_key;
+    gl::GLint is_palettized;
+    gl::GLint palette_texture;
+    gl::GLint tile_id;
+    gl::GLint quad;
+  } uniforms_;
+
+  /// @brief Uniforms, depending on tileset
+  struct TilesetUniforms
+  {
+    glm::uvec2 tile_count{ 0 };
+    /// @brief Color key (w: 1 if enabled)
+    glm::vec4 color_key{ 0 };
+    /// @brief Palette texture (0 if tileset is not palettized)
+    gl::GLuint palette{ 0 };
+
+    auto operator!=(const TilesetUniforms& other) const -> bool
+    {
+      return tile_count != other.tile_count or color_key != other.color_key or
+             palette != other.palette;
+    }
+  };
+
+  const Tileset* tileset_{ nullptr };
+  /// @brief Values, currently set in program's uniforms
+  TilesetUniforms tileset_uniforms_;
 };
 }
\ No newline at end of file
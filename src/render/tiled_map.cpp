@@ -1,69 +1,316 @@
-#include <utils/json.hpp>
+#include <cstring>
+#include <unordered_set>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
 
 #include <render/tiled_map.hpp>
+#include <utils/encoding.hpp>
+#include <utils/mapped_file.hpp>
 
 using namespace render;
 
 namespace {
 auto
-transform_index(TiledMap::TileIndex& index) -> void
+transform_index(TiledMap::TileIndex index) -> TiledMap::TileIndex
 {
-  if (index == 0) {
-    index = TiledMap::invalid_index;
-  } else {
-    index--;
-  }
+  return index == 0 ? TiledMap::invalid_index : index - 1;
 }
 
-auto
-parse_layer(const nlohmann::json& layer_definition,
-            render::TiledMap::TileLayer tag)
+/**
+ * @brief Streaming parser of Tiled's JSON map
+ *
+ * Only map's size and layers are extracted, the rest of document is skipped.
+ * Tile indices of CSV layers (JSON arrays) are transformed and written
+ * directly into the layer, without building a DOM. Layers encoded in base64
+ * (optionally zlib / gzip compressed) are decoded once the layer ends.
+ *
+ * Keys required by the map (`width`, `height`, `layers`) and its layers
+ * (`name`, `visible`, `type` and tile layer's `data`) are checked once their
+ * object ends.
+ */
+class TiledMapSaxHandler : public nlohmann::json_sax<nlohmann::json>
 {
-  decltype(tag) result;
-  result.tile_indices_ =
-    layer_definition.at("data").get<std::vector<unsigned>>();
+public:
+  explicit TiledMapSaxHandler(TiledMap& map)
+    : map_{ map }
+  {
+  }
 
-  std::for_each(
-    result.tile_indices_.begin(), result.tile_indices_.end(), transform_index);
-  return result;
-}
+  auto null() -> bool override { return true; }
 
-auto
-parse_layer(const nlohmann::json& layer_definition,
-            render::TiledMap::ObjectLayer tag)
-{
-  return tag;
-}
+  auto boolean(bool value) -> bool override
+  {
+    if (is_in(Context::layer) and key_ == "visible") {
+      layer_.visible_ = value;
+    }
+    return true;
+  }
+
+  auto number_integer(number_integer_t value) -> bool override
+  {
+    return number(value);
+  }
+
+  auto number_unsigned(number_unsigned_t value) -> bool override
+  {
+    return number(value);
+  }
+
+  auto number_float(number_float_t, const string_t&) -> bool override
+  {
+    return true;
+  }
+
+  auto string(string_t& value) -> bool override
+  {
+    if (is_in(Context::layer)) {
+      if (key_ == "name") {
+        layer_.name_ = std::move(value);
+      } else if (key_ == "type") {
+        is_tile_layer_ = value == "tilelayer";
+      } else if (key_ == "encoding") {
+        encoding_ = std::move(value);
+      } else if (key_ == "compression") {
+        compression_ = std::move(value);
+      } else if (key_ == "data") {
+        encoded_data_ = std::move(value);
+      }
+    }
+    return true;
+  }
+
+  auto binary(binary_t&) -> bool override { return true; }
+
+  auto start_object(std::size_t) -> bool override
+  {
+    if (contexts_.empty()) {
+      contexts_.push_back(Context::root);
+    } else if (is_in(Context::layers)) {
+      begin_layer();
+      contexts_.push_back(Context::layer);
+    } else {
+      contexts_.push_back(Context::other);
+    }
+    return true;
+  }
+
+  auto end_object() -> bool override
+  {
+    if (is_in(Context::layer)) {
+      end_layer();
+    }
+    contexts_.pop_back();
+    return true;
+  }
+
+  auto start_array(std::size_t) -> bool override
+  {
+    if (is_in(Context::root) and key_ == "layers") {
+      contexts_.push_back(Context::layers);
+    } else if (is_in(Context::layer) and key_ == "data") {
+      // Tiled writes keys alphabetically, so sizes of both the layer and the
+      // map usually follow the data. Preallocate only, when one precedes it.
+      const auto layer_size = layer_width_ * layer_height_;
+      const auto map_size = std::size_t{ map_.count_x } * map_.count_y;
+      tile_indices_.reserve(layer_size > 0 ? layer_size : map_size);
+      contexts_.push_back(Context::layer_data);
+    } else {
+      contexts_.push_back(Context::other);
+    }
+    return true;
+  }
+
+  auto end_array() -> bool override
+  {
+    contexts_.pop_back();
+    return true;
+  }
+
+  auto key(string_t& value) -> bool override
+  {
+    if (is_in(Context::root)) {
+      root_keys_.insert(value);
+      key_ = std::move(value);
+    } else if (is_in(Context::layer)) {
+      layer_keys_.insert(value);
+      key_ = std::move(value);
+    }
+    return true;
+  }
+
+  /// @brief Check the map, once the whole document is parsed
+  auto end_map() const -> void
+  {
+    for (const auto* key : { "width", "height", "layers" }) {
+      if (root_keys_.count(key) == 0) {
+        throw std::runtime_error(fmt::format("missing map's '{}'", key));
+      }
+    }
+  }
+
+  auto parse_error(std::size_t position,
+                   const std::string&,
+                   const nlohmann::detail::exception& error) -> bool override
+  {
+    throw std::runtime_error(
+      fmt::format("parse error at byte {}: {}", position, error.what()));
+  }
+
+private:
+  enum class Context
+  {
+    root,
+    layers,
+    layer,
+    layer_data,
+    other
+  };
+
+  auto is_in(Context context) const -> bool
+  {
+    return not contexts_.empty() and contexts_.back() == context;
+  }
+
+  template<typename T>
+  auto number(T value) -> bool
+  {
+    if (is_in(Context::layer_data)) {
+      tile_indices_.push_back(
+        transform_index(static_cast<TiledMap::TileIndex>(value)));
+    } else if (is_in(Context::root)) {
+      if (key_ == "width") {
+        map_.count_x = static_cast<unsigned>(value);
+      } else if (key_ == "height") {
+        map_.count_y = static_cast<unsigned>(value);
+      }
+    } else if (is_in(Context::layer)) {
+      if (key_ == "width") {
+        layer_width_ = static_cast<std::size_t>(value);
+      } else if (key_ == "height") {
+        layer_height_ = static_cast<std::size_t>(value);
+      }
+    }
+    return true;
+  }
+
+  auto begin_layer() -> void
+  {
+    layer_ = TiledMap::Layer{};
+    is_tile_layer_ = false;
+    encoding_.clear();
+    compression_.clear();
+    encoded_data_.clear();
+    tile_indices_ = {};
+    layer_width_ = 0;
+    layer_height_ = 0;
+    layer_keys_.clear();
+  }
+
+  auto end_layer() -> void
+  {
+    for (const auto* key : { "name", "visible", "type" }) {
+      require_layer_key(key);
+    }
+    if (not is_tile_layer_) {
+      layer_.data_ = TiledMap::ObjectLayer{};
+    } else {
+      require_layer_key("data");
+      if (not encoded_data_.empty()) {
+        decode_layer_data();
+      }
+      const auto layer_size = layer_width_ * layer_height_;
+      if (layer_size > 0 and tile_indices_.size() != layer_size) {
+        throw std::runtime_error(
+          fmt::format("Layer '{}': {} tiles, but its size is {}x{}",
+                      layer_.name_,
+                      tile_indices_.size(),
+                      layer_width_,
+                      layer_height_));
+      }
+      // Without preallocation, the indices have grown geometrically
+      tile_indices_.shrink_to_fit();
+      layer_.data_ = TiledMap::TileLayer{ std::move(tile_indices_) };
+    }
+    map_.layers_.push_back(std::move(layer_));
+  }
+
+  auto require_layer_key(const char* key) const -> void
+  {
+    if (layer_keys_.count(key) == 0) {
+      throw std::runtime_error(
+        fmt::format("Layer {}: missing '{}'", map_.layers_.size(), key));
+    }
+  }
+
+  /// @brief Decode base64 (and compressed) layer data into tile indices
+  auto decode_layer_data() -> void
+  {
+    if (encoding_ != "base64") {
+      throw std::runtime_error(fmt::format(
+        "Layer '{}': unsupported encoding '{}'", layer_.name_, encoding_));
+    }
+
+    auto bytes = utils::decode_base64(encoded_data_);
+    if (compression_ == "zlib" or compression_ == "gzip") {
+      bytes = utils::inflate(bytes,
+                             layer_width_ * layer_height_ *
+                               sizeof(TiledMap::TileIndex));
+    } else if (not compression_.empty()) {
+      throw std::runtime_error(fmt::format(
+        "Layer '{}': unsupported compression '{}'", layer_.name_, compression_));
+    }
+
+    // Global tile IDs are stored as 32-bit little-endian integers
+    tile_indices_.resize(bytes.size() / 4);
+    for (std::size_t i = 0; i < tile_indices_.size(); i++) {
+      const auto* gid = &bytes[i * 4];
+      tile_indices_[i] = transform_index(
+        gid[0] | (gid[1] << 8) | (gid[2] << 16) |
+        (static_cast<TiledMap::TileIndex>(gid[3]) << 24));
+    }
+  }
+
+  TiledMap& map_;
+  std::vector<Context> contexts_;
+  /// @brief Last key of root / layer object
+  std::string key_;
+  std::unordered_set<std::string> root_keys_;
+
+  /* Layer being parsed */
+  TiledMap::Layer layer_;
+  bool is_tile_layer_{ false };
+  std::string encoding_;
+  std::string compression_;
+  std::string encoded_data_;
+  std::vector<TiledMap::TileIndex> tile_indices_;
+  std::size_t layer_width_{ 0 };
+  std::size_t layer_height_{ 0 };
+  std::unordered_set<std::string> layer_keys_;
+};
 } // namespace
 
 auto
 TiledMap::load_map(const std::filesystem::path& file,
                    std::shared_ptr<render::Tileset> tileset)
   -> std::shared_ptr<render::TiledMap>
-{
+try {
+  SPDLOG_TRACE("TiledMap::load_map: {}", file.c_str());
   auto tilemap = std::make_shared<render::TiledMap>();
-  auto map = utils::read_json(file);
-  {
-    tilemap->tileset_ = tileset;
-
-    for (const auto& layer_definition : map.at("layers")) {
-      Layer layer;
-      layer.name_ = layer_definition.at("name");
-      layer.visible_ = layer_definition.at("visible");
+  tilemap->tileset_ = tileset;
 
-      bool is_tilelayer = layer_definition.at("type") == "tilelayer";
-      if (is_tilelayer) {
-        layer.data_ = parse_layer(layer_definition, TiledMap::TileLayer{});
-      } else {
-        layer.data_ = parse_layer(layer_definition, TiledMap::ObjectLayer{});
-      }
-      tilemap->layers_.push_back(layer);
-    }
+  const utils::MappedFile mapping{ file };
+  const auto* begin = reinterpret_cast<const char*>(mapping.get_data());
+  const auto* end = begin + mapping.get_size();
 
-    tilemap->count_x = map.at("width");
-    tilemap->count_y = map.at("height");
-  }
+  TiledMapSaxHandler handler{ *tilemap };
+  nlohmann::json::sax_parse(begin, end, &handler);
+  handler.end_map();
+  tilemap->validate();
   return tilemap;
+} catch (const std::exception& e) {
+  throw std::runtime_error(
+    fmt::format("TiledMap::load_map: '{}': {}", file.c_str(), e.what()));
 }
 
 auto
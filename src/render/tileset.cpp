@@ -3,24 +3,88 @@
 #include <render/loader.hpp>
 #include <render/tileset.hpp>
 #include <utils/color.hpp>
+#include <utils/hash.hpp>
+#include <utils/mapped_file.hpp>
 
 using namespace render;
 
 auto
-Tileset::load_tileset(const std::filesystem::path& file)
-  -> std::shared_ptr<render::Tileset>
+Tileset::Decoded::upload() const -> std::shared_ptr<render::Tileset>
+{
+  auto& tilesets = utils::ResourceCache<Tileset>::get();
+  if (key_) {
+    if (auto resident = tilesets.find(*key_)) {
+      return resident;
+    }
+  }
+
+  auto& textures = utils::ResourceCache<const Texture>::get();
+  if (image_key_) {
+    tileset_->texture_ = textures.find(*image_key_);
+  }
+
+  if (image_.is_palettized()) {
+    // Palette is resident as long as its texture
+    auto palette_key = image_key_;
+    if (palette_key) {
+      palette_key->path_ += "#palette";
+      tileset_->palette_ = textures.find(*palette_key);
+    }
+    if (not tileset_->palette_) {
+      tileset_->palette_ =
+        std::make_shared<const Texture>(render::upload_palette(image_));
+      if (palette_key) {
+        tileset_->palette_ = textures.insert(*palette_key, tileset_->palette_);
+      }
+    }
+  }
+
+  if (not tileset_->texture_) {
+    // Texture might have been released since decoding skipped the image
+    const auto image =
+      image_.pixels_ ? image_ : render::load_image_from_file(image_path_);
+    tileset_->texture_ =
+      std::make_shared<const Texture>(render::upload_texture(image));
+    if (image_key_) {
+      tileset_->texture_ = textures.insert(*image_key_, tileset_->texture_);
+    }
+  }
+
+  if (image_.pixels_) {
+    tileset_->texture_size_ =
+      image_.get_pixels_size() +
+      (image_.is_palettized() ? ImageData::palette_size * 4 : 0);
+  }
+
+  return key_ ? tilesets.insert(*key_, tileset_) : tileset_;
+}
+
+auto
+Tileset::decode_tileset(const std::filesystem::path& file) -> Decoded
 {
   auto tileset = std::make_shared<render::Tileset>();
 
-  auto tiles = utils::read_json(file);
+  // Each file is read once, both for its key and its content
+  const utils::MappedFile definition{ file };
+  auto tiles = utils::read_json(file, definition.get_view());
+  auto key = utils::ResourceKey::from_content(file, definition.get_view());
 
-  std::optional<utils::Color> transparent_color;
   if (tiles.contains("transparentcolor")) {
-    transparent_color =
+    tileset->transparent_color_ =
       utils::Color(tiles.at("transparentcolor").get<std::string>());
   }
-  tileset->texture_ = render::load_texture_from_file(
-    file.parent_path() / tiles.at("image"), transparent_color);
+  auto image_path = file.parent_path() / tiles.at("image");
+  tileset->image_path_ = image_path;
+  const utils::MappedFile image_file{ image_path };
+  auto image_key =
+    utils::ResourceKey::from_content(image_path, image_file.get_view());
+  // Tileset depends on its image too (e.g. when only the image is edited)
+  key.content_hash_ =
+    utils::hash_combine(key.content_hash_, image_key.content_hash_);
+  ImageData image;
+  if (not utils::ResourceCache<const Texture>::get().contains(image_key)) {
+    image = render::load_image_from_memory(image_file.get_view(), image_path);
+  }
 
   const auto image_width = tiles.value("imagewidth", 1);
   const auto tile_width = tiles.value("tilewidth", 1);
@@ -37,6 +101,8 @@ Tileset::load_tileset(const std::filesystem::path& file)
   }
 
   tileset->total_tiles_ = tiles.value("tilecount", 1);
+  // Exact size is known after decoding (which might be skipped)
+  tileset->texture_size_ = std::size_t{ 4 } * image_width * image_height;
 
   if (tiles.contains("tiles")) {
     for (const auto tile : tiles.at("tiles")) {
@@ -53,5 +119,16 @@ Tileset::load_tileset(const std::filesystem::path& file)
       tileset->animations.at(id) = result;
     }
   }
-  return tileset;
-}
\ No newline at end of file
+  return Decoded{ tileset,
+                  std::move(image),
+                  std::move(image_path),
+                  std::move(key),
+                  std::move(image_key) };
+}
+
+auto
+Tileset::load_tileset(const std::filesystem::path& file)
+  -> std::shared_ptr<render::Tileset>
+{
+  return decode_tileset(file).upload();
+}
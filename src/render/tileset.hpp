@@ -1,8 +1,16 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <render/loader.hpp>
 #include <render/resource.hpp>
+#include <utils/color.hpp>
+#include <utils/resource_cache.hpp>
 
 namespace render {
 /**
@@ -26,7 +34,37 @@ struct Tileset
   unsigned int tile_size_y_{ 0 };
   // unsigned int tiles_per_row_{0};
   unsigned int total_tiles_{ 0 };
-  Texture texture_;
+  /// @brief Texture (shared by all tilesets using the same image)
+  std::shared_ptr<const Texture> texture_;
+  /// @brief Palette, when `texture_` holds palette indices (see ImageData)
+  std::shared_ptr<const Texture> palette_;
+  /// @brief Memory of texture & palette in bytes (estimated before upload)
+  std::size_t texture_size_{ 0 };
+  /// @brief Color, rendered as transparent (keyed out in shader)
+  std::optional<utils::Color> transparent_color_;
+  /// @brief Source of the texture (empty when not loaded from file)
+  std::filesystem::path image_path_;
+
+  /// @brief Tileset with decoded image, waiting for its texture upload
+  struct Decoded
+  {
+    std::shared_ptr<Tileset> tileset_;
+    /// @brief Pixels (empty when the texture was already resident)
+    ImageData image_;
+    /// @brief Source of `image_` (empty when not loaded from file)
+    std::filesystem::path image_path_;
+    /// @brief Keys into `utils::ResourceCache` (when cacheable)
+    std::optional<utils::ResourceKey> key_;
+    std::optional<utils::ResourceKey> image_key_;
+
+    /// @brief Create tileset's texture (requires GL context)
+    /// @note Returns resident tileset/texture from the cache, when possible
+    auto upload() const -> std::shared_ptr<render::Tileset>;
+  };
+
+  /// @brief Parse definition & decode image (without touching OpenGL)
+  /// @note Decoding of images with a resident texture is skipped
+  static auto decode_tileset(const std::filesystem::path& file) -> Decoded;
 
   static auto load_tileset(const std::filesystem::path& file)
     -> std::shared_ptr<render::Tileset>;
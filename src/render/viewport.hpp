@@ -2,8 +2,16 @@
 
 #include <glm/glm.hpp>
 
+#include <utils/aabb.hpp>
+
 namespace render {
 
+/**
+ * @brief Screen area with a 2D camera looking into the world
+ *
+ * Camera is defined by its position (center of view, in world units) and
+ * zoom (screen pixels per world unit).
+ */
 class Viewport
 {
 public:
@@ -15,8 +23,29 @@ public:
   auto origin(const glm::vec2 origin) -> void { origin_ = origin; }
   auto size(const glm::vec2 size) -> void { size_ = size; }
 
+  /* Camera */
+  auto get_camera_position() const -> glm::vec2 { return camera_position_; }
+  auto get_zoom() const -> float { return zoom_; }
+
+  auto camera_position(const glm::vec2 position) -> void
+  {
+    camera_position_ = position;
+  }
+  auto zoom(const float zoom) -> void { zoom_ = zoom; }
+
+  /// @brief Part of world visible by camera (in world units)
+  auto get_visible_area() const -> utils::AABB
+  {
+    const auto visible_size = size_ / glm::vec2(zoom_);
+    return utils::AABB{ camera_position_ - visible_size * glm::vec2(0.5),
+                        visible_size };
+  }
+
 private:
   glm::vec2 origin_{ 0 };
   glm::vec2 size_{ 640, 480 };
+
+  glm::vec2 camera_position_{ 0 };
+  float zoom_{ 32.0f };
 };
-} // namespace
\ No newline at end of file
+} // namespace
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+#include <lyra/lyra.hpp>
+#include <spdlog/cfg/env.h>
+#include <spdlog/spdlog.h>
+
+#include <bm/interfaces/game.hpp>
+#include <bm/level.hpp>
+#include <bm/replay_journal.hpp>
+#include <bm/simulation.hpp>
+#include <render/tiled_map.hpp>
+#include <utils/allocation_tracker.hpp>
+#include <utils/json.hpp>
+#include <utils/profiler.hpp>
+
+enum ReturnCodes
+{
+  success = 0,
+  parsing_error = 1,
+  runtime_error = 2,
+  replay_mismatch = 3,
+  allocation_budget_exceeded = 4
+};
+
+namespace {
+/// @brief Game without window: level's map only (no tilesets, no GL)
+class HeadlessGame : public bm::interfaces::IGame
+{
+public:
+  HeadlessGame(const std::filesystem::path& assets_directory,
+               const std::filesystem::path& level)
+    : level_{ utils::read_json(assets_directory / level) }
+  {
+    level_.map_ = render::TiledMap::load_map(
+      assets_directory / level_.settings_.tilemap_path, nullptr);
+  }
+
+  auto get_current_level() const -> const bm::Level* override
+  {
+    return &level_;
+  }
+
+private:
+  bm::Level level_;
+};
+} // namespace
+
+/**
+ * @brief Replays a journal (see `bm::ReplayJournal`) without window
+ *
+ * The match is simulated as fast as possible and its final state is verified
+ * against the recorded one. Repeated runs (and the profiler trace) make it a
+ * benchmark of game logic.
+ *
+ * Without journal, the match is simulated for a count of ticks, without any
+ * input (e.g. on a level by b0mb3rman-generate, to measure cost of its size).
+ *
+ * With an allocation budget (requires a build with allocation tracking), the
+ * replay fails, if any tick after the warm-up allocates more than that.
+ */
+int
+main(int argc, const char* argv[])
+{
+  spdlog::set_level(spdlog::level::info);
+  spdlog::cfg::load_env_levels();
+
+  std::string assets_directory{ "./assets" };
+  std::string level{ "levels/default.json" };
+  std::string journal_file;
+  unsigned repeat = 1;
+  unsigned ticks = 0;
+  std::string trace_file;
+  int allocation_budget = -1;
+  unsigned warm_up_ticks = 60;
+
+  auto cli =
+    lyra::cli() |
+    lyra::opt(journal_file, "journal")["-j"]["--journal"](
+      "Journal, recorded by b0mb3rman --record") |
+    lyra::opt(assets_directory, "assets")["-a"]["--assets"](
+      "Path to assets directory") |
+    lyra::opt(level, "level")["-l"]["--level"](
+      "Level definition (JSON), relative to assets") |
+    lyra::opt(ticks, "count")["-t"]["--ticks"](
+      "Simulate count of ticks without input (instead of journal)") |
+    lyra::opt(repeat, "count")["-r"]["--repeat"]("Count of replays") |
+    lyra::opt(trace_file, "trace_file")["--trace"](
+      "Write recent profiler zones as Chrome trace (JSON)") |
+    lyra::opt(allocation_budget, "count")["--allocation-budget"](
+      "Fail if a tick allocates more (-1: unchecked)") |
+    lyra::opt(warm_up_ticks, "count")["--warm-up"](
+      "Ticks, not checked against allocation budget");
+
+  const auto result = cli.parse({ argc, argv });
+  if (!result) {
+    spdlog::error("Failed to parse cli: {}", result.message());
+    return ReturnCodes::parsing_error;
+  }
+
+  try {
+    if (journal_file.empty() and ticks == 0) {
+      spdlog::error("Missing journal (--journal) or count of ticks (--ticks)");
+      return ReturnCodes::parsing_error;
+    }
+    if (allocation_budget >= 0 and not utils::AllocationTracker::is_enabled) {
+      spdlog::error("Allocation budget requires a build with allocation "
+                    "tracking (b0mb3rman_ENABLE_ALLOCATION_TRACKING)");
+      return ReturnCodes::parsing_error;
+    }
+    HeadlessGame game{ assets_directory, level };
+    bm::ReplayJournal journal;
+    if (not journal_file.empty()) {
+      journal = bm::ReplayJournal::read(journal_file);
+      spdlog::info("Replaying {} inputs (seed {})",
+                   journal.entries_.size(),
+                   journal.seed_);
+    } else {
+      journal.seed_ = bm::Simulation::default_seed;
+      journal.tick_duration_ms_ = bm::Simulation::tick_duration.count();
+      journal.final_tick_ = ticks;
+      spdlog::info("Simulating {} ticks", ticks);
+    }
+
+    for (unsigned i = 0; i < repeat; i++) {
+      bm::GameController::Texts texts;
+      bm::Simulation simulation{ game,
+                                 texts,
+                                 bm::Simulation::Settings{ true } };
+      simulation.load_static_collisions(*game.get_current_level()->map_);
+
+      utils::AllocationBudget budget{
+        static_cast<std::uint64_t>(std::max(allocation_budget, 0)),
+        warm_up_ticks
+      };
+      const auto begin = std::chrono::steady_clock::now();
+      const auto state_hash =
+        simulation.replay(journal, [&budget]() { budget.end_frame(); });
+      const auto elapsed = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - begin);
+      utils::Profiler::get().end_frame();
+
+      spdlog::info("Replay {}: {:.3f} ms ({:.3f} ms per tick), {} entities, "
+                   "state {:016x}",
+                   i + 1,
+                   elapsed.count(),
+                   elapsed.count() / std::max(simulation.get_tick(), 1u),
+                   simulation.world_.size(),
+                   state_hash);
+      if (journal.final_state_hash_ and
+          *journal.final_state_hash_ != state_hash) {
+        spdlog::error("Replay diverged (recorded state {:016x})",
+                      *journal.final_state_hash_);
+        return ReturnCodes::replay_mismatch;
+      }
+
+      if (utils::AllocationTracker::is_enabled) {
+        const auto worst = budget.get_worst_frame();
+        spdlog::info("Replay {}: {} steady ticks, at most {} allocations "
+                     "({} bytes) per tick",
+                     i + 1,
+                     budget.get_checked_frames(),
+                     worst.allocations_,
+                     worst.bytes_);
+      }
+      if (allocation_budget >= 0 and budget.is_exceeded()) {
+        spdlog::error("{} of {} steady ticks exceeded allocation budget of {}",
+                      budget.get_exceeded_frames(),
+                      budget.get_checked_frames(),
+                      allocation_budget);
+        return ReturnCodes::allocation_budget_exceeded;
+      }
+    }
+
+    if (not trace_file.empty()) {
+      utils::Profiler::get().write_chrome_trace(trace_file);
+      spdlog::info("Profiler trace written to '{}'", trace_file);
+    }
+  } catch (std::exception& e) {
+    spdlog::critical("Replay failed: {}", e.what());
+    return ReturnCodes::runtime_error;
+  }
+
+  return ReturnCodes::success;
+}
@@ -0,0 +1,100 @@
+#include <utils/allocation_tracker.hpp>
+
+#include <cstdlib>
+#include <new>
+
+using namespace utils;
+
+namespace {
+// Constant-initialized & trivially destructible, so it's safe to use from
+// allocations during thread's start and exit
+thread_local AllocationTracker::Counters thread_counters;
+} // namespace
+
+auto
+AllocationTracker::get_thread_counters() -> Counters
+{
+  return thread_counters;
+}
+
+AllocationBudget::AllocationBudget(std::uint64_t max_allocations,
+                                   unsigned warm_up_frames)
+  : max_allocations_{ max_allocations }
+  , warm_up_frames_{ warm_up_frames }
+  , frame_begin_{ AllocationTracker::get_thread_counters() }
+{
+}
+
+auto
+AllocationBudget::end_frame() -> void
+{
+  const auto now = AllocationTracker::get_thread_counters();
+  const auto frame = now - frame_begin_;
+  frame_begin_ = now;
+
+  if (frames_++ < warm_up_frames_) {
+    return;
+  }
+  checked_frames_++;
+  if (frame.allocations_ > max_allocations_) {
+    exceeded_frames_++;
+  }
+  if (frame.allocations_ > worst_frame_.allocations_) {
+    worst_frame_ = frame;
+  }
+}
+
+#if defined(B0MB3RMAN_ALLOCATION_TRACKING)
+namespace {
+auto
+allocate(std::size_t size, std::size_t alignment) -> void*
+{
+  thread_counters.allocations_++;
+  thread_counters.bytes_ += size;
+
+  // Neither malloc nor aligned_alloc are required to serve zero bytes
+  size = size == 0 ? 1 : size;
+  while (true) {
+    auto* pointer =
+      alignment == 0
+        ? std::malloc(size)
+        : std::aligned_alloc(alignment,
+                             (size + alignment - 1) / alignment * alignment);
+    if (pointer) {
+      return pointer;
+    }
+    const auto handler = std::get_new_handler();
+    if (not handler) {
+      throw std::bad_alloc{};
+    }
+    handler();
+  }
+}
+} // namespace
+
+// Replaceable allocation functions. The rest of them (array, nothrow & sized
+// forms) are defined by the standard library in terms of these four.
+void*
+operator new(std::size_t size)
+{
+  return allocate(size, 0);
+}
+
+void*
+operator new(std::size_t size, std::align_val_t alignment)
+{
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void
+operator delete(void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void
+operator delete(void* pointer, std::align_val_t) noexcept
+{
+  std::free(pointer);
+}
+#endif
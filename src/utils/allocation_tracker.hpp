@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+
+namespace utils {
+
+/**
+ * @brief Counts heap allocations of the calling thread
+ *
+ * With B0MB3RMAN_ALLOCATION_TRACKING defined (opt-in, it replaces global
+ * `operator new` & `operator delete` of the whole executable), every
+ * allocation increments counters of the allocating thread. Otherwise,
+ * counters stay at zero and nothing is replaced.
+ *
+ * Counters only grow (frees are not counted), so allocations of a scope are
+ * the difference of counters at its end and at its begin (see
+ * `Profiler::Zone` and `AllocationBudget`).
+ */
+class AllocationTracker
+{
+public:
+#if defined(B0MB3RMAN_ALLOCATION_TRACKING)
+  static constexpr bool is_enabled = true;
+#else
+  static constexpr bool is_enabled = false;
+#endif
+
+  struct Counters
+  {
+    std::uint64_t allocations_{ 0 };
+    /// @brief Requested bytes
+    std::uint64_t bytes_{ 0 };
+
+    auto operator-(const Counters& other) const -> Counters
+    {
+      return Counters{ allocations_ - other.allocations_,
+                       bytes_ - other.bytes_ };
+    }
+  };
+
+  /// @brief Allocations of the calling thread since its start
+  static auto get_thread_counters() -> Counters;
+};
+
+/**
+ * @brief Checks, that frames stay within a budget of allocations
+ *
+ * Frames are delimited by `end_frame()`, allocations are those of the
+ * thread calling it. First `warm_up_frames` frames (e.g. loading, caches
+ * and pools growing) are not checked.
+ */
+class AllocationBudget
+{
+public:
+  AllocationBudget(std::uint64_t max_allocations, unsigned warm_up_frames);
+
+  auto end_frame() -> void;
+
+  /// @brief Checked (steady-state) frames so far
+  auto get_checked_frames() const -> unsigned { return checked_frames_; }
+  /// @brief Checked frames over the budget
+  auto get_exceeded_frames() const -> unsigned { return exceeded_frames_; }
+  auto is_exceeded() const -> bool { return exceeded_frames_ > 0; }
+  /// @brief Checked frame of most allocations
+  auto get_worst_frame() const -> AllocationTracker::Counters
+  {
+    return worst_frame_;
+  }
+
+private:
+  std::uint64_t max_allocations_;
+  unsigned warm_up_frames_;
+
+  unsigned frames_{ 0 };
+  unsigned checked_frames_{ 0 };
+  unsigned exceeded_frames_{ 0 };
+  AllocationTracker::Counters frame_begin_;
+  AllocationTracker::Counters worst_frame_;
+};
+
+} // namespace utils
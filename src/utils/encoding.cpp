@@ -0,0 +1,146 @@
+#include <utils/encoding.hpp>
+
+#include <array>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <zlib.h>
+
+using namespace utils;
+
+namespace {
+constexpr std::uint8_t invalid_sextet = 0xFF;
+
+constexpr std::string_view base64_alphabet =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+constexpr auto
+make_base64_table() -> std::array<std::uint8_t, 256>
+{
+  std::array<std::uint8_t, 256> table{};
+  for (auto& value : table) {
+    value = invalid_sextet;
+  }
+
+  for (std::size_t i = 0; i < base64_alphabet.size(); i++) {
+    table[static_cast<unsigned char>(base64_alphabet[i])] =
+      static_cast<std::uint8_t>(i);
+  }
+  return table;
+}
+
+constexpr auto base64_table = make_base64_table();
+} // namespace
+
+auto
+utils::encode_base64(const std::vector<std::uint8_t>& input) -> std::string
+{
+  std::string result;
+  result.reserve((input.size() + 2) / 3 * 4);
+
+  std::size_t i = 0;
+  for (; i + 2 < input.size(); i += 3) {
+    const std::uint32_t triple =
+      (input[i] << 16) | (input[i + 1] << 8) | input[i + 2];
+    result.push_back(base64_alphabet[(triple >> 18) & 0x3F]);
+    result.push_back(base64_alphabet[(triple >> 12) & 0x3F]);
+    result.push_back(base64_alphabet[(triple >> 6) & 0x3F]);
+    result.push_back(base64_alphabet[triple & 0x3F]);
+  }
+
+  // Last 1 or 2 bytes, padded
+  if (i < input.size()) {
+    const auto has_second = i + 1 < input.size();
+    const std::uint32_t triple =
+      (input[i] << 16) | (has_second ? input[i + 1] << 8 : 0);
+    result.push_back(base64_alphabet[(triple >> 18) & 0x3F]);
+    result.push_back(base64_alphabet[(triple >> 12) & 0x3F]);
+    result.push_back(has_second ? base64_alphabet[(triple >> 6) & 0x3F] : '=');
+    result.push_back('=');
+  }
+  return result;
+}
+
+auto
+utils::decode_base64(std::string_view input) -> std::vector<std::uint8_t>
+{
+  std::vector<std::uint8_t> result;
+  result.reserve(input.size() / 4 * 3);
+
+  std::uint32_t buffer = 0;
+  unsigned buffered_bits = 0;
+  for (const auto c : input) {
+    if (c == '=') {
+      break;
+    }
+    if (c == ' ' or c == '\n' or c == '\r' or c == '\t') {
+      continue;
+    }
+
+    const auto sextet = base64_table[static_cast<unsigned char>(c)];
+    if (sextet == invalid_sextet) {
+      throw std::runtime_error(
+        fmt::format("decode_base64: invalid character '{}'", c));
+    }
+
+    buffer = (buffer << 6) | sextet;
+    buffered_bits += 6;
+    if (buffered_bits >= 8) {
+      buffered_bits -= 8;
+      result.push_back(static_cast<std::uint8_t>(buffer >> buffered_bits));
+    }
+  }
+  return result;
+}
+
+auto
+utils::inflate(const std::vector<std::uint8_t>& input, std::size_t size_hint)
+  -> std::vector<std::uint8_t>
+{
+  ::z_stream stream{};
+  // 15: max. window, +32: detect zlib / gzip header automatically
+  if (::inflateInit2(&stream, 15 + 32) != Z_OK) {
+    throw std::runtime_error("inflate: failed to initialize zlib");
+  }
+
+  std::vector<std::uint8_t> result(size_hint > 0 ? size_hint
+                                                 : input.size() * 4 + 64);
+  stream.next_in = const_cast<::Bytef*>(input.data());
+  stream.avail_in = static_cast<::uInt>(input.size());
+
+  int status = Z_OK;
+  while (status != Z_STREAM_END) {
+    if (stream.total_out == result.size()) {
+      result.resize(result.size() * 2);
+    }
+    stream.next_out = result.data() + stream.total_out;
+    stream.avail_out = static_cast<::uInt>(result.size() - stream.total_out);
+
+    status = ::inflate(&stream, Z_NO_FLUSH);
+    if (status != Z_OK and status != Z_STREAM_END) {
+      const auto message = stream.msg ? stream.msg : "truncated stream";
+      ::inflateEnd(&stream);
+      throw std::runtime_error(fmt::format("inflate: {}", message));
+    }
+  }
+
+  result.resize(stream.total_out);
+  ::inflateEnd(&stream);
+  return result;
+}
+
+auto
+utils::deflate(const std::vector<std::uint8_t>& input, int level)
+  -> std::vector<std::uint8_t>
+{
+  auto size = ::compressBound(static_cast<::uLong>(input.size()));
+  std::vector<std::uint8_t> result(size);
+  const auto status =
+    ::compress2(result.data(), &size, input.data(), input.size(), level);
+  if (status != Z_OK) {
+    throw std::runtime_error(
+      fmt::format("deflate: failed to compress ({})", status));
+  }
+  result.resize(size);
+  return result;
+}
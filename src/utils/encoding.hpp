@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace utils {
+
+/// @brief Encode base64 (RFC 4648, padded)
+auto
+encode_base64(const std::vector<std::uint8_t>& input) -> std::string;
+
+/// @brief Decode base64 (RFC 4648, whitespace is skipped)
+auto
+decode_base64(std::string_view input) -> std::vector<std::uint8_t>;
+
+/**
+ * @brief Decompress zlib or gzip stream (detected by header)
+ *
+ * @param size_hint Expected size of output (for preallocation, 0: unknown)
+ */
+auto
+inflate(const std::vector<std::uint8_t>& input, std::size_t size_hint = 0)
+  -> std::vector<std::uint8_t>;
+
+/// @brief Compress into zlib stream (`level`: 0 - 9, -1: zlib's default)
+auto
+deflate(const std::vector<std::uint8_t>& input, int level = -1)
+  -> std::vector<std::uint8_t>;
+
+} // namespace utils
@@ -0,0 +1,102 @@
+#include <utils/file_watcher.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+using namespace utils;
+
+namespace {
+constexpr auto file_events = IN_CLOSE_WRITE | IN_MOVED_TO;
+constexpr auto directory_events = IN_CREATE | IN_ISDIR;
+} // namespace
+
+FileWatcher::FileWatcher(const std::filesystem::path& directory)
+  : descriptor_{ ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC) }
+{
+  if (descriptor_ < 0) {
+    throw std::runtime_error(fmt::format(
+      "FileWatcher: failed to initialize inotify: {}", std::strerror(errno)));
+  }
+
+  try {
+    add_watch(directory);
+    for (const auto& entry :
+         std::filesystem::recursive_directory_iterator(directory)) {
+      if (entry.is_directory()) {
+        add_watch(entry.path());
+      }
+    }
+  } catch (...) {
+    ::close(descriptor_);
+    throw;
+  }
+}
+
+FileWatcher::~FileWatcher()
+{
+  ::close(descriptor_);
+}
+
+auto
+FileWatcher::poll() -> std::vector<std::filesystem::path>
+{
+  std::vector<std::filesystem::path> result;
+
+  alignas(inotify_event) std::array<char, 4096> buffer;
+  while (true) {
+    const auto length = ::read(descriptor_, buffer.data(), buffer.size());
+    if (length <= 0) {
+      // EAGAIN: no more events
+      break;
+    }
+
+    for (auto offset = 0l; offset < length;) {
+      const auto* event =
+        reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+      offset += sizeof(inotify_event) + event->len;
+
+      const auto directory = directories_.find(event->wd);
+      if (directory == directories_.end() or event->len == 0) {
+        continue;
+      }
+
+      const auto path = directory->second / event->name;
+      if ((event->mask & directory_events) == directory_events) {
+        try {
+          add_watch(path);
+        } catch (const std::exception& e) {
+          // E.g. editor's temporary directory, removed in the meantime
+          spdlog::warn("{}", e.what());
+        }
+      } else if ((event->mask & file_events) and
+                 std::find(result.begin(), result.end(), path) ==
+                   result.end()) {
+        result.push_back(path);
+      }
+    }
+  }
+  return result;
+}
+
+auto
+FileWatcher::add_watch(const std::filesystem::path& directory) -> void
+{
+  const auto watch = ::inotify_add_watch(
+    descriptor_, directory.c_str(), file_events | IN_CREATE | IN_ONLYDIR);
+  if (watch < 0) {
+    throw std::runtime_error(fmt::format("FileWatcher: failed to watch '{}': {}",
+                                         directory.c_str(),
+                                         std::strerror(errno)));
+  }
+  SPDLOG_TRACE("FileWatcher: watching '{}'", directory.c_str());
+  directories_[watch] = directory;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Watches a directory tree for modified files (via inotify)
+ *
+ * Changes are collected by the kernel and only read out by (non-blocking)
+ * `poll()`, so the watcher can be polled once per frame. A file is reported
+ * once it is closed after writing, or moved into the tree (as editors do
+ * when saving atomically). Newly created subdirectories are watched too.
+ */
+class FileWatcher
+{
+public:
+  explicit FileWatcher(const std::filesystem::path& directory);
+  ~FileWatcher();
+
+  FileWatcher(const FileWatcher&) = delete;
+  FileWatcher& operator=(const FileWatcher&) = delete;
+
+  /// @brief Files, modified since the last poll (each reported once)
+  auto poll() -> std::vector<std::filesystem::path>;
+
+private:
+  auto add_watch(const std::filesystem::path& directory) -> void;
+
+  int descriptor_{ -1 };
+  /// @brief Watched directory per watch descriptor
+  std::unordered_map<int, std::filesystem::path> directories_;
+};
+
+} // namespace utils
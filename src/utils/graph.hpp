@@ -6,6 +6,8 @@
 #include <utility>
 #include <variant>
 
+#include <utils/hash.hpp>
+
 namespace utils {
 namespace detail {
 struct pair_hash
@@ -13,7 +15,10 @@ struct pair_hash
   template<class T1, class T2>
   std::size_t operator()(const std::pair<T1, T2>& pair) const
   {
-    return std::hash<T1>()(pair.first) ^ std::hash<T2>()(pair.second);
+    // Combined, since a plain xor hashes self-loops to zero and collides
+    // for (a, b) and (b, a)
+    return hash_combine(std::hash<T1>()(pair.first),
+                        std::hash<T2>()(pair.second));
   }
 };
 
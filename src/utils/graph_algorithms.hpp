@@ -1,7 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <iterator>
 #include <queue>
+#include <stdexcept>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace utils {
 namespace graph_algorithms {
@@ -99,11 +105,12 @@ make_reflexive(const G& graph) -> G
 {
   // Complexity: O(v+e)
   auto result = graph;
-  for (const auto& vertex : result.get_vertices()) {
+  for (const auto& vertex : graph.get_vertices()) {
     result.add_edge(vertex, vertex);
   }
 
-  for (const auto& [edge, _] : result.get_edges()) {
+  // Iterate the source: adding edges to `result` may rehash it
+  for (const auto& [edge, _] : graph.get_edges()) {
     result.add_edge(edge.first, edge.first);
     result.add_edge(edge.second, edge.second);
   }
@@ -117,7 +124,7 @@ make_symmetric(const G& graph) -> G
   auto result = graph;
 
   // Complexity: O(e)
-  for (const auto& [edge, _] : result.get_edges()) {
+  for (const auto& [edge, _] : graph.get_edges()) {
     result.add_edge(edge.second, edge.first);
   }
   return result;
@@ -290,8 +297,13 @@ compute_path(const G& graph, NodeId start, NodeId end) -> std::vector<NodeId>
     }
     visited_vertices.insert(vertex);
 
-    // append neighbours as next reachable vertices
+    // append neighbours as next reachable vertices (the first visit of a
+    // vertex is the shortest one, keep its predecessor)
     for (const auto& next : graph.get_neighbours(vertex)) {
+      if (visited_vertices.count(next) > 0 or
+          previous_vertices.count(next) > 0) {
+        continue;
+      }
       previous_vertices[next] = vertex;
       remaining_vertices.push(next);
     }
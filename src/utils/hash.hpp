@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+namespace utils {
+
+/**
+ * @brief Mix hash `value` into `seed` (as boost::hash_combine does)
+ *
+ * Unlike a plain xor, equal values don't cancel out and the order of
+ * combined values matters.
+ */
+constexpr auto
+hash_combine(std::size_t seed, std::size_t value) -> std::size_t
+{
+  return seed ^ (value + static_cast<std::size_t>(0x9e3779b97f4a7c15) +
+                 (seed << 6) + (seed >> 2));
+}
+
+} // namespace utils
@@ -7,6 +7,7 @@
 
 namespace utils {
 
+/// @note Prefer `utils::MappedFile` when the content is only read
 auto
 read_text_file(const std::filesystem::path& path) -> std::string;
 
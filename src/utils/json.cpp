@@ -1,12 +1,13 @@
 #include <spdlog/spdlog.h>
 #include <utils/json.hpp>
+#include <utils/mapped_file.hpp>
 
 using namespace utils;
 
 auto
 utils::read_json(const std::filesystem::path& path) -> nlohmann::json
 {
-  spdlog::trace("utils::read_json: {}", path.c_str());
+  SPDLOG_TRACE("utils::read_json: {}", path.c_str());
 
   if (!std::filesystem::exists(path)) {
     throw std::runtime_error(
@@ -14,10 +15,36 @@ utils::read_json(const std::filesystem::path& path) -> nlohmann::json
   }
 
   try {
-    std::ifstream file(path);
-    return nlohmann::json::parse(file);
+    const MappedFile file{ path };
+    const auto content = file.get_view();
+    return nlohmann::json::parse(content.begin(), content.end());
   } catch (const std::exception& e) {
     throw std::runtime_error(
       fmt::format("read_json: '{}': {}", path.c_str(), e.what()));
   }
 }
+
+auto
+utils::read_json(const std::filesystem::path& path, std::string_view content)
+  -> nlohmann::json
+try {
+  return nlohmann::json::parse(content.begin(), content.end());
+} catch (const nlohmann::json::exception& e) {
+  throw std::runtime_error(
+    fmt::format("read_json: '{}': {}", path.c_str(), e.what()));
+}
+
+auto
+utils::write_json(const std::filesystem::path& path,
+                  const nlohmann::json& json,
+                  int indent) -> void
+{
+  SPDLOG_TRACE("utils::write_json: {}", path.c_str());
+
+  std::ofstream output{ path };
+  output << json.dump(indent) << '\n';
+  if (not output) {
+    throw std::runtime_error(
+      fmt::format("write_json: failed to write '{}'", path.c_str()));
+  }
+}
@@ -4,10 +4,22 @@
 #include <fmt/format.h>
 #include <fstream>
 #include <nlohmann/json.hpp>
+#include <string_view>
 
 namespace utils {
 
 auto
 read_json(const std::filesystem::path& path) -> nlohmann::json;
 
+/// @brief Parse `content` of `path`, which has already been read
+auto
+read_json(const std::filesystem::path& path, std::string_view content)
+  -> nlohmann::json;
+
+/// @brief Write JSON (indented by `indent` spaces, -1: compact)
+auto
+write_json(const std::filesystem::path& path,
+           const nlohmann::json& json,
+           int indent = 2) -> void;
+
 } // namespace utils
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <utils/mapped_file.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include <utils/raii_helpers.hpp>
+
+using namespace utils;
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+  const auto descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    throw std::runtime_error(fmt::format(
+      "MappedFile: failed to open '{}': {}", path.c_str(), std::strerror(errno)));
+  }
+  // Mapping stays valid after the descriptor is closed
+  auto close_guard = utils::make_raii_action([=]() { ::close(descriptor); });
+
+  struct ::stat status;
+  if (::fstat(descriptor, &status) != 0) {
+    throw std::runtime_error(fmt::format(
+      "MappedFile: failed to stat '{}': {}", path.c_str(), std::strerror(errno)));
+  }
+
+  // Size of non-regular files is not known in advance
+  if (not S_ISREG(status.st_mode) or status.st_size == 0) {
+    read_into_buffer(descriptor);
+    return;
+  }
+
+  size_ = static_cast<std::size_t>(status.st_size);
+  auto* mapping =
+    ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  if (mapping == MAP_FAILED) {
+    read_into_buffer(descriptor);
+    return;
+  }
+  data_ = static_cast<const std::byte*>(mapping);
+  is_mapped_ = true;
+}
+
+MappedFile::~MappedFile()
+{
+  if (is_mapped_) {
+    ::munmap(const_cast<std::byte*>(data_), size_);
+  }
+}
+
+auto
+MappedFile::read_into_buffer(int descriptor) -> void
+{
+  constexpr std::size_t chunk_size = 64 * 1024;
+  std::size_t total = 0;
+  while (true) {
+    buffer_.resize(total + chunk_size);
+    const auto count = ::read(descriptor, buffer_.data() + total, chunk_size);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error(
+        fmt::format("MappedFile: failed to read: {}", std::strerror(errno)));
+    }
+    if (count == 0) {
+      break;
+    }
+    total += static_cast<std::size_t>(count);
+  }
+  buffer_.resize(total);
+  data_ = buffer_.data();
+  size_ = total;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The mapping lives as long as the object, so data can be referenced
+ * (instead of copied) by anyone holding the object. Files that cannot be
+ * mapped (e.g. pipes or procfs entries) are read into a buffer instead.
+ */
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::filesystem::path& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  auto get_data() const -> const std::byte* { return data_; }
+  auto get_size() const -> std::size_t { return size_; }
+
+  /// @brief Content as text (valid as long as the object lives)
+  auto get_view() const -> std::string_view
+  {
+    return { reinterpret_cast<const char*>(data_), size_ };
+  }
+
+  auto is_mapped() const -> bool { return is_mapped_; }
+
+private:
+  auto read_into_buffer(int descriptor) -> void;
+
+  const std::byte* data_{ nullptr };
+  std::size_t size_{ 0 };
+  bool is_mapped_{ false };
+
+  /// @brief Content, when mapping is not possible
+  std::vector<std::byte> buffer_;
+};
+
+} // namespace utils
@@ -0,0 +1,238 @@
+#include <utils/metrics.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+using namespace utils;
+
+auto
+MetricsRegistry::get() -> MetricsRegistry&
+{
+  static MetricsRegistry registry;
+  return registry;
+}
+
+MetricsRegistry::~MetricsRegistry()
+{
+  for (auto& shard : shards_) {
+    for (auto& chunk : shard->chunks_) {
+      delete chunk.load(std::memory_order_acquire);
+    }
+  }
+}
+
+auto
+MetricsRegistry::register_shard() -> Shard*
+{
+  // Shards are owned by the registry (and outlive their threads), so that
+  // counts of finished threads are kept
+  std::lock_guard lock{ mutex_ };
+  return shards_.emplace_back(std::make_unique<Shard>()).get();
+}
+
+auto
+MetricsRegistry::allocate_chunk(Shard& shard, std::uint32_t index) -> Chunk*
+{
+  if (index >= max_chunks) {
+    throw std::runtime_error(
+      fmt::format("Metrics: slot {} out of range", index * chunk_size));
+  }
+  auto* chunk = new Chunk{};
+  shard.chunks_[index].store(chunk, std::memory_order_release);
+  return chunk;
+}
+
+auto
+MetricsRegistry::read_slot(std::uint32_t slot) const -> std::uint64_t
+{
+  std::lock_guard lock{ mutex_ };
+  std::uint64_t result = 0;
+  for (const auto& shard : shards_) {
+    const auto* chunk =
+      shard->chunks_[slot / chunk_size].load(std::memory_order_acquire);
+    if (chunk) {
+      result += chunk->slots_[slot % chunk_size].load(
+        std::memory_order_relaxed);
+    }
+  }
+  return result;
+}
+
+auto
+MetricsRegistry::register_metric(const std::string& name,
+                                 const std::string& labels,
+                                 const char* type,
+                                 std::uint32_t slot_count) -> std::uint32_t
+{
+  std::lock_guard lock{ mutex_ };
+  const auto found = metrics_.find({ name, labels });
+  if (found != metrics_.end()) {
+    if (std::strcmp(found->second.type_, type) != 0) {
+      throw std::runtime_error(
+        fmt::format("Metrics: '{}' already registered as {}",
+                    name,
+                    found->second.type_));
+    }
+    return found->second.slot_;
+  }
+
+  std::uint32_t slot = 0;
+  if (std::strcmp(type, "gauge") == 0) {
+    slot = static_cast<std::uint32_t>(gauges_.size());
+    gauges_.emplace_back(0);
+  } else {
+    if (slot_count_ + slot_count > chunk_size * max_chunks) {
+      throw std::runtime_error(
+        fmt::format("Metrics: out of slots registering '{}'", name));
+    }
+    slot = slot_count_;
+    slot_count_ += slot_count;
+  }
+  metrics_.emplace(std::pair{ name, labels },
+                   Metric{ name, labels, type, slot });
+  return slot;
+}
+
+auto
+MetricsRegistry::get_gauge_value(std::uint32_t index)
+  -> std::atomic<std::int64_t>&
+{
+  std::lock_guard lock{ mutex_ };
+  return gauges_.at(index);
+}
+
+auto
+Histogram::get_snapshot() const -> Snapshot
+{
+  auto& registry = MetricsRegistry::get();
+  Snapshot result;
+  result.buckets_.resize(bucket_count);
+  for (std::uint32_t bucket = 0; bucket < bucket_count; bucket++) {
+    result.buckets_[bucket] = registry.read_slot(slot_ + bucket);
+    result.count_ += result.buckets_[bucket];
+  }
+  result.sum_ = registry.read_slot(slot_ + bucket_count);
+  return result;
+}
+
+auto
+Histogram::Snapshot::get_quantile(double quantile) const -> std::uint64_t
+{
+  if (count_ == 0) {
+    return 0;
+  }
+  const auto rank = static_cast<std::uint64_t>(
+    std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count_ - 1));
+  std::uint64_t seen = 0;
+  for (std::uint32_t bucket = 0; bucket < buckets_.size(); bucket++) {
+    seen += buckets_[bucket];
+    if (seen > rank) {
+      return get_bucket_limit(bucket) - 1;
+    }
+  }
+  return get_bucket_limit(bucket_count - 1) - 1;
+}
+
+namespace {
+
+auto
+format_labels(const std::string& labels, const std::string& extra = "")
+  -> std::string
+{
+  if (labels.empty() and extra.empty()) {
+    return "";
+  }
+  if (labels.empty() or extra.empty()) {
+    return fmt::format("{{{}{}}}", labels, extra);
+  }
+  return fmt::format("{{{},{}}}", labels, extra);
+}
+
+} // namespace
+
+auto
+MetricsRegistry::write_prometheus(std::ostream& output) const -> void
+{
+  std::vector<Metric> metrics;
+  {
+    std::lock_guard lock{ mutex_ };
+    for (const auto& [key, metric] : metrics_) {
+      metrics.push_back(metric);
+    }
+  }
+
+  const std::string* previous_name = nullptr;
+  for (const auto& metric : metrics) {
+    if (not previous_name or *previous_name != metric.name_) {
+      output << fmt::format("# TYPE {} {}\n", metric.name_, metric.type_);
+      previous_name = &metric.name_;
+    }
+
+    if (std::strcmp(metric.type_, "counter") == 0) {
+      output << fmt::format("{}{} {}\n",
+                            metric.name_,
+                            format_labels(metric.labels_),
+                            read_slot(metric.slot_));
+    } else if (std::strcmp(metric.type_, "gauge") == 0) {
+      std::int64_t value = 0;
+      {
+        std::lock_guard lock{ mutex_ };
+        value = gauges_[metric.slot_].load(std::memory_order_relaxed);
+      }
+      output << fmt::format(
+        "{}{} {}\n", metric.name_, format_labels(metric.labels_), value);
+    } else {
+      // Cumulative buckets, only where the count changes (all buckets would
+      // make hundreds of lines per histogram)
+      std::uint64_t count = 0;
+      for (std::uint32_t bucket = 0; bucket < Histogram::bucket_count;
+           bucket++) {
+        const auto value = read_slot(metric.slot_ + bucket);
+        if (value == 0) {
+          continue;
+        }
+        count += value;
+        output << fmt::format(
+          "{}_bucket{} {}\n",
+          metric.name_,
+          format_labels(metric.labels_,
+                        fmt::format("le=\"{}\"",
+                                    Histogram::get_bucket_limit(bucket) - 1)),
+          count);
+      }
+      output << fmt::format("{}_bucket{} {}\n",
+                            metric.name_,
+                            format_labels(metric.labels_, "le=\"+Inf\""),
+                            count);
+      output << fmt::format(
+        "{}_sum{} {}\n",
+        metric.name_,
+        format_labels(metric.labels_),
+        read_slot(metric.slot_ + Histogram::bucket_count));
+      output << fmt::format(
+        "{}_count{} {}\n", metric.name_, format_labels(metric.labels_), count);
+    }
+  }
+}
+
+auto
+MetricsRegistry::write_prometheus(const std::filesystem::path& file) const
+  -> void
+{
+  // Scrapers (e.g. node_exporter's textfile collector) must never see a
+  // partially written file
+  auto temporary = file;
+  temporary += ".tmp";
+  {
+    std::ofstream output(temporary, std::ios::trunc);
+    write_prometheus(output);
+    if (not output) {
+      throw std::runtime_error(
+        fmt::format("Metrics: failed to write '{}'", temporary.c_str()));
+    }
+  }
+  std::filesystem::rename(temporary, file);
+}
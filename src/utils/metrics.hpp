@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Process-wide registry of runtime metrics (counters, gauges and
+ * latency histograms)
+ *
+ * Counters and histograms are sharded per thread: each thread increments
+ * its own slots (relaxed atomics, no read-modify-write, no locks), shards
+ * are merged when metrics are read. Gauges hold a single value.
+ *
+ * Metrics are identified by a name and (optional) Prometheus labels, e.g.
+ * `Counter{ "events_enqueued_total", "type=\"Foo\"" }`. Creating a handle
+ * takes a lock, hence hot paths should keep handles (e.g. as members).
+ */
+class MetricsRegistry
+{
+public:
+  /// @brief Slots per chunk of a shard (chunks are allocated on first use)
+  static constexpr std::uint32_t chunk_size = 1024;
+  static constexpr std::uint32_t max_chunks = 256;
+
+  struct Chunk
+  {
+    std::array<std::atomic<std::uint64_t>, chunk_size> slots_{};
+  };
+
+  /// @brief Slots of a single thread
+  struct Shard
+  {
+    std::array<std::atomic<Chunk*>, max_chunks> chunks_{};
+  };
+
+  static auto get() -> MetricsRegistry&;
+
+  ~MetricsRegistry();
+
+  /// @brief Calling thread's slot (hot path)
+  auto get_slot(std::uint32_t slot) -> std::atomic<std::uint64_t>&
+  {
+    thread_local Shard* shard = nullptr;
+    if (not shard) {
+      shard = register_shard();
+    }
+    auto* chunk = shard->chunks_[slot / chunk_size].load(
+      std::memory_order_relaxed);
+    if (not chunk) {
+      chunk = allocate_chunk(*shard, slot / chunk_size);
+    }
+    return chunk->slots_[slot % chunk_size];
+  }
+
+  /// @brief Sum of `slot` over all threads
+  auto read_slot(std::uint32_t slot) const -> std::uint64_t;
+
+  /// @brief Allocate (or find already allocated) slots of a metric
+  /// @return First slot (or gauge's index)
+  auto register_metric(const std::string& name,
+                       const std::string& labels,
+                       const char* type,
+                       std::uint32_t slot_count) -> std::uint32_t;
+
+  auto get_gauge_value(std::uint32_t index) -> std::atomic<std::int64_t>&;
+
+  /// @brief Write all metrics in Prometheus text exposition format
+  auto write_prometheus(std::ostream& output) const -> void;
+  /// @brief Replace `file` (atomically) with current metrics
+  auto write_prometheus(const std::filesystem::path& file) const -> void;
+
+private:
+  struct Metric
+  {
+    std::string name_;
+    std::string labels_;
+    /// @brief "counter", "gauge" or "histogram"
+    const char* type_;
+    std::uint32_t slot_;
+  };
+
+  MetricsRegistry() = default;
+
+  auto register_shard() -> Shard*;
+  auto allocate_chunk(Shard& shard, std::uint32_t index) -> Chunk*;
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::uint32_t slot_count_{ 0 };
+  /// @brief Metrics by name & labels (ordered for output)
+  std::map<std::pair<std::string, std::string>, Metric> metrics_;
+  std::deque<std::atomic<std::int64_t>> gauges_;
+};
+
+/// @brief Monotonically increasing count (e.g. of events)
+class Counter
+{
+public:
+  Counter() = delete;
+  explicit Counter(const std::string& name, const std::string& labels = "")
+    : slot_{ MetricsRegistry::get().register_metric(name,
+                                                    labels,
+                                                    "counter",
+                                                    1) }
+  {
+  }
+
+  auto increment(std::uint64_t value = 1) const -> void
+  {
+    // Only the calling thread writes its slot, so no atomic RMW is needed
+    auto& slot = MetricsRegistry::get().get_slot(slot_);
+    slot.store(slot.load(std::memory_order_relaxed) + value,
+               std::memory_order_relaxed);
+  }
+
+  auto get_value() const -> std::uint64_t
+  {
+    return MetricsRegistry::get().read_slot(slot_);
+  }
+
+private:
+  std::uint32_t slot_{ 0 };
+};
+
+/// @brief Current value of something (e.g. queue depth)
+class Gauge
+{
+public:
+  Gauge() = delete;
+  explicit Gauge(const std::string& name, const std::string& labels = "")
+    : value_{ &MetricsRegistry::get().get_gauge_value(
+        MetricsRegistry::get().register_metric(name, labels, "gauge", 0)) }
+  {
+  }
+
+  auto set(std::int64_t value) const -> void
+  {
+    value_->store(value, std::memory_order_relaxed);
+  }
+  auto add(std::int64_t delta) const -> void
+  {
+    value_->fetch_add(delta, std::memory_order_relaxed);
+  }
+  auto get_value() const -> std::int64_t
+  {
+    return value_->load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<std::int64_t>* value_{ nullptr };
+};
+
+/**
+ * @brief Distribution of values (e.g. latencies in nanoseconds)
+ *
+ * Buckets are log-linear (HDR-style): values below 8 have exact buckets,
+ * each further power of two is split into 8 buckets (so a bucket is within
+ * 12.5 % of its values). Values from 2^40 up share the last bucket.
+ */
+class Histogram
+{
+public:
+  static constexpr unsigned sub_bucket_bits = 3;
+  static constexpr std::uint64_t sub_bucket_count = 1 << sub_bucket_bits;
+  static constexpr unsigned max_exponent = 40;
+  static constexpr std::uint32_t bucket_count =
+    sub_bucket_count + (max_exponent - sub_bucket_bits) * sub_bucket_count;
+
+  struct Snapshot
+  {
+    std::vector<std::uint64_t> buckets_;
+    std::uint64_t count_{ 0 };
+    std::uint64_t sum_{ 0 };
+
+    /// @brief Upper bound of the bucket, `quantile` of values falls into
+    auto get_quantile(double quantile) const -> std::uint64_t;
+  };
+
+  Histogram() = delete;
+  explicit Histogram(const std::string& name, const std::string& labels = "")
+    : slot_{ MetricsRegistry::get().register_metric(name,
+                                                    labels,
+                                                    "histogram",
+                                                    bucket_count + 1) }
+  {
+  }
+
+  auto record(std::uint64_t value) const -> void
+  {
+    auto& registry = MetricsRegistry::get();
+    auto& bucket = registry.get_slot(slot_ + get_bucket(value));
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_relaxed);
+    auto& sum = registry.get_slot(slot_ + bucket_count);
+    sum.store(sum.load(std::memory_order_relaxed) + value,
+              std::memory_order_relaxed);
+  }
+
+  auto record(std::chrono::nanoseconds duration) const -> void
+  {
+    record(static_cast<std::uint64_t>(std::max<std::int64_t>(
+      duration.count(), 0)));
+  }
+
+  auto get_snapshot() const -> Snapshot;
+
+  static constexpr auto get_bucket(std::uint64_t value) -> std::uint32_t
+  {
+    if (value < sub_bucket_count) {
+      return static_cast<std::uint32_t>(value);
+    }
+    // Index of the highest set bit (binary search, branches are predictable
+    // for similar values)
+    unsigned exponent = 0;
+    for (unsigned step = 32; step > 0; step /= 2) {
+      if (value >> (exponent + step)) {
+        exponent += step;
+      }
+    }
+    if (exponent >= max_exponent) {
+      return bucket_count - 1;
+    }
+    const auto shift = exponent - sub_bucket_bits;
+    const auto sub_bucket = (value >> shift) & (sub_bucket_count - 1);
+    return static_cast<std::uint32_t>(sub_bucket_count +
+                                      shift * sub_bucket_count + sub_bucket);
+  }
+
+  /// @brief Smallest value, which does not fall into `bucket` anymore
+  static constexpr auto get_bucket_limit(std::uint32_t bucket)
+    -> std::uint64_t
+  {
+    if (bucket < sub_bucket_count) {
+      return bucket + 1;
+    }
+    const auto shift = (bucket - sub_bucket_count) / sub_bucket_count;
+    const auto sub_bucket = (bucket - sub_bucket_count) % sub_bucket_count;
+    return (sub_bucket_count + sub_bucket + 1) << shift;
+  }
+
+private:
+  std::uint32_t slot_{ 0 };
+};
+
+} // namespace utils
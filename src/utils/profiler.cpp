@@ -0,0 +1,195 @@
+#include <utils/profiler.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+using namespace utils;
+
+Profiler::Profiler()
+  : start_{ Clock::now() }
+{
+}
+
+auto
+Profiler::get() -> Profiler&
+{
+  static Profiler profiler;
+  return profiler;
+}
+
+auto
+Profiler::record(const ZoneRecord& zone) -> void
+{
+  auto& buffer = get_thread_buffer();
+  const auto head = buffer.head_.load(std::memory_order_relaxed);
+  buffer.records_[head % buffer_capacity] = zone;
+  buffer.head_.store(head + 1, std::memory_order_release);
+}
+
+auto
+Profiler::get_thread_buffer() -> ThreadBuffer&
+{
+  // Buffers are owned by the profiler (and outlive their threads), so that
+  // zones of finished threads still make it to the trace
+  thread_local ThreadBuffer* buffer = nullptr;
+  if (not buffer) {
+    std::lock_guard lock{ mutex_ };
+    auto& created = buffers_.emplace_back(std::make_unique<ThreadBuffer>());
+    created->thread_id_ = static_cast<std::uint32_t>(buffers_.size());
+    buffer = created.get();
+  }
+  return *buffer;
+}
+
+auto
+Profiler::read(const ThreadBuffer& buffer,
+               std::uint64_t from,
+               std::uint64_t to) const -> std::vector<ZoneRecord>
+{
+  const auto oldest = to > buffer_capacity ? to - buffer_capacity : 0;
+  from = std::max(from, oldest);
+
+  // Seqlock-style read: records are copied while the writer may overwrite
+  // them (formally a data race, but records are trivially copyable) and
+  // those, which might have been overwritten, are dropped afterwards
+  std::vector<ZoneRecord> result;
+  result.reserve(to - from);
+  for (auto i = from; i < to; i++) {
+    result.push_back(buffer.records_[i % buffer_capacity]);
+  }
+
+  // The writer stores record `head` before it publishes `head + 1`, so the
+  // record `head - capacity` (in the same slot) may be torn as well
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const auto head = buffer.head_.load(std::memory_order_relaxed);
+  const auto first = to - result.size();
+  if (head + 1 > first + buffer_capacity) {
+    const auto overwritten = std::min<std::uint64_t>(
+      head + 1 - (first + buffer_capacity), result.size());
+    result.erase(result.begin(), result.begin() + overwritten);
+  }
+  return result;
+}
+
+auto
+Profiler::record_duration(const char* name, std::chrono::nanoseconds duration)
+  -> void
+{
+  std::lock_guard lock{ mutex_ };
+  accumulate(name, duration.count(), {});
+}
+
+auto
+Profiler::accumulate(const char* name,
+                     std::int64_t duration,
+                     const AllocationTracker::Counters& allocations) -> void
+{
+  auto [iterator, is_new] = statistics_.try_emplace(name);
+  if (is_new) {
+    zone_order_.push_back(name);
+  }
+  auto& statistics = iterator->second;
+  statistics.duration_.current_ += duration;
+  statistics.allocations_.current_ +=
+    static_cast<std::int64_t>(allocations.allocations_);
+  statistics.allocated_bytes_.current_ +=
+    static_cast<std::int64_t>(allocations.bytes_);
+}
+
+auto
+Profiler::RollingSum::end_frame(std::size_t slot) -> void
+{
+  sum_ += current_ - frames_[slot];
+  frames_[slot] = current_;
+  current_ = 0;
+}
+
+auto
+Profiler::RollingSum::get_maximum() const -> std::int64_t
+{
+  return *std::max_element(frames_.begin(), frames_.end());
+}
+
+auto
+Profiler::end_frame() -> void
+{
+  std::lock_guard lock{ mutex_ };
+  for (auto& buffer : buffers_) {
+    const auto head = buffer->head_.load(std::memory_order_acquire);
+    const auto records = read(*buffer, buffer->aggregated_, head);
+    buffer->aggregated_ = head;
+    for (const auto& record : records) {
+      accumulate(
+        record.name_, record.end_ - record.begin_, record.allocations_);
+    }
+  }
+
+  // Zones, missing in this frame, contribute by zero
+  const auto slot = frame_++ % window_frames;
+  for (auto& [name, statistics] : statistics_) {
+    statistics.duration_.end_frame(slot);
+    statistics.allocations_.end_frame(slot);
+    statistics.allocated_bytes_.end_frame(slot);
+  }
+}
+
+auto
+Profiler::get_statistics() const -> std::vector<ZoneStatistics>
+{
+  std::lock_guard lock{ mutex_ };
+  const auto frame_count = static_cast<std::int64_t>(
+    std::clamp<std::size_t>(frame_, 1, window_frames));
+
+  std::vector<ZoneStatistics> result;
+  for (const auto* name : zone_order_) {
+    const auto& statistics = statistics_.at(name);
+    result.push_back(ZoneStatistics{
+      name,
+      std::chrono::nanoseconds{ statistics.duration_.sum_ / frame_count },
+      std::chrono::nanoseconds{ statistics.duration_.get_maximum() },
+      static_cast<std::uint64_t>(statistics.allocations_.sum_ / frame_count),
+      static_cast<std::uint64_t>(statistics.allocated_bytes_.sum_ /
+                                 frame_count),
+      static_cast<std::uint64_t>(statistics.allocations_.get_maximum()) });
+  }
+  return result;
+}
+
+auto
+Profiler::write_chrome_trace(const std::filesystem::path& file) const -> void
+{
+  auto events = nlohmann::json::array();
+  {
+    std::lock_guard lock{ mutex_ };
+    for (const auto& buffer : buffers_) {
+      const auto head = buffer->head_.load(std::memory_order_acquire);
+      for (const auto& record : read(*buffer, 0, head)) {
+        // Complete events, timestamps in microseconds
+        auto event =
+          nlohmann::json{ { "name", record.name_ },
+                          { "ph", "X" },
+                          { "ts", record.begin_ / 1000.0 },
+                          { "dur", (record.end_ - record.begin_) / 1000.0 },
+                          { "pid", 1 },
+                          { "tid", buffer->thread_id_ } };
+        if (record.allocations_.allocations_ > 0) {
+          event["args"] = { { "allocations", record.allocations_.allocations_ },
+                            { "bytes", record.allocations_.bytes_ } };
+        }
+        events.push_back(std::move(event));
+      }
+    }
+  }
+
+  std::ofstream output(file, std::ios::trunc);
+  output << nlohmann::json{ { "traceEvents", std::move(events) },
+                            { "displayTimeUnit", "ms" } };
+  if (not output) {
+    throw std::runtime_error(
+      fmt::format("Profiler: failed to write '{}'", file.c_str()));
+  }
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <utils/allocation_tracker.hpp>
+
+namespace utils {
+
+/**
+ * @brief Profiler of scoped zones on the hot path (e.g. stages of a frame)
+ *
+ * Zones are recorded into per-thread ring buffers (the recording thread is
+ * the only writer, no locks are taken). Once per frame, `end_frame()`
+ * aggregates zones finished since the previous frame into rolling averages
+ * (e.g. for an overlay). Recent zones of all threads can be exported as a
+ * Chrome trace (viewable in Perfetto or chrome://tracing).
+ *
+ * Zones are placed via `PROFILE_ZONE("name")`, which compiles to nothing
+ * unless B0MB3RMAN_PROFILER is defined. Zone names must be string literals
+ * (zones are identified by the pointer).
+ *
+ * With allocation tracking (see `AllocationTracker`), zones also count heap
+ * allocations of their thread (nested zones' ones included).
+ */
+class Profiler
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief Records kept per thread (older ones are overwritten)
+  static constexpr std::size_t buffer_capacity = 1 << 16;
+  /// @brief Frames of rolling averages
+  static constexpr std::size_t window_frames = 60;
+
+  struct ZoneRecord
+  {
+    const char* name_;
+    /// @brief Nanoseconds since profiler's creation
+    std::int64_t begin_;
+    std::int64_t end_;
+    /// @brief Nesting level within the thread (0: outermost)
+    std::uint32_t depth_;
+    /// @brief Allocations during the zone (zero without allocation tracking)
+    AllocationTracker::Counters allocations_;
+  };
+
+  struct ZoneStatistics
+  {
+    const char* name_;
+    /// @brief Average time per frame (zones of a frame are summed)
+    std::chrono::nanoseconds average_;
+    /// @brief Maximum time per frame in the window
+    std::chrono::nanoseconds maximum_;
+    /// @brief Average allocations per frame
+    std::uint64_t allocations_;
+    /// @brief Average allocated bytes per frame
+    std::uint64_t allocated_bytes_;
+    /// @brief Maximum allocations per frame in the window
+    std::uint64_t maximum_allocations_;
+  };
+
+  /// @brief Measures its lifetime as a zone of the calling thread
+  class Zone
+  {
+  public:
+    explicit Zone(const char* name)
+      : name_{ name }
+      , begin_{ get().now() }
+      , depth_{ get_depth()++ }
+      , allocations_{ get_allocations() }
+    {
+    }
+    ~Zone()
+    {
+      get_depth()--;
+      const auto allocations = get_allocations() - allocations_;
+      get().record(
+        ZoneRecord{ name_, begin_, get().now(), depth_, allocations });
+    }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+  private:
+    static auto get_depth() -> std::uint32_t&
+    {
+      thread_local std::uint32_t depth{ 0 };
+      return depth;
+    }
+    static auto get_allocations() -> AllocationTracker::Counters
+    {
+      if constexpr (AllocationTracker::is_enabled) {
+        return AllocationTracker::get_thread_counters();
+      } else {
+        return {};
+      }
+    }
+
+    const char* name_;
+    std::int64_t begin_;
+    std::uint32_t depth_;
+    AllocationTracker::Counters allocations_;
+  };
+
+  static auto get() -> Profiler&;
+
+  /// @brief Nanoseconds since profiler's creation
+  auto now() const -> std::int64_t
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             Clock::now() - start_)
+      .count();
+  }
+
+  /// @brief Append a finished zone to the calling thread's buffer
+  auto record(const ZoneRecord& zone) -> void;
+
+  /// @brief Add time measured elsewhere (e.g. on GPU) to the current frame
+  /// @note Such durations are part of statistics, but not of traces
+  auto record_duration(const char* name, std::chrono::nanoseconds duration)
+    -> void;
+
+  /// @brief Aggregate zones, finished since the last call, as a frame
+  /// @note Expected to be called once per frame (by a single thread)
+  auto end_frame() -> void;
+
+  /// @brief Rolling averages, in order of first appearance of zones
+  auto get_statistics() const -> std::vector<ZoneStatistics>;
+
+  /// @brief Write recent zones of all threads as Chrome trace_event JSON
+  auto write_chrome_trace(const std::filesystem::path& file) const -> void;
+
+private:
+  struct ThreadBuffer
+  {
+    std::uint32_t thread_id_;
+    /// @brief Count of records ever written (next is at head_ % capacity)
+    std::atomic<std::uint64_t> head_{ 0 };
+    /// @brief Records, already aggregated by `end_frame()`
+    std::uint64_t aggregated_{ 0 };
+    std::array<ZoneRecord, buffer_capacity> records_;
+  };
+
+  struct RollingSum
+  {
+    std::array<std::int64_t, window_frames> frames_{};
+    std::int64_t sum_{ 0 };
+    /// @brief Sum in the frame being aggregated
+    std::int64_t current_{ 0 };
+
+    /// @brief Move the current frame to the window's `slot`
+    auto end_frame(std::size_t slot) -> void;
+    auto get_maximum() const -> std::int64_t;
+  };
+
+  struct RollingStatistics
+  {
+    RollingSum duration_;
+    RollingSum allocations_;
+    RollingSum allocated_bytes_;
+  };
+
+  Profiler();
+
+  auto get_thread_buffer() -> ThreadBuffer&;
+  /// @brief Add to zone's sums in the current frame (under `mutex_`)
+  auto accumulate(const char* name,
+                  std::int64_t duration,
+                  const AllocationTracker::Counters& allocations) -> void;
+  /// @brief Copy records [from, to), which are still present in `buffer`
+  auto read(const ThreadBuffer& buffer,
+            std::uint64_t from,
+            std::uint64_t to) const -> std::vector<ZoneRecord>;
+
+  const Clock::time_point start_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+  std::size_t frame_{ 0 };
+  std::vector<const char*> zone_order_;
+  std::unordered_map<const char*, RollingStatistics> statistics_;
+};
+
+} // namespace utils
+
+#define PROFILE_CONCATENATE_IMPL(a, b) a##b
+#define PROFILE_CONCATENATE(a, b) PROFILE_CONCATENATE_IMPL(a, b)
+
+#if defined(B0MB3RMAN_PROFILER)
+/// @brief Profile the rest of the enclosing scope as zone `name`
+#define PROFILE_ZONE(name)                                                     \
+  const ::utils::Profiler::Zone PROFILE_CONCATENATE(profile_zone_, __LINE__)   \
+  {                                                                            \
+    name                                                                       \
+  }
+#else
+#define PROFILE_ZONE(name)
+#endif
@@ -0,0 +1,21 @@
+#include <utils/mapped_file.hpp>
+#include <utils/resource_cache.hpp>
+
+#include <string_view>
+
+using namespace utils;
+
+auto
+ResourceKey::from_file(const std::filesystem::path& file) -> ResourceKey
+{
+  const MappedFile content{ file };
+  return from_content(file, content.get_view());
+}
+
+auto
+ResourceKey::from_content(const std::filesystem::path& file,
+                          std::string_view content) -> ResourceKey
+{
+  return ResourceKey{ std::filesystem::canonical(file).string(),
+                      std::hash<std::string_view>{}(content) };
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace utils {
+
+/// @brief Identity of a resource: where it comes from and what it contains
+struct ResourceKey
+{
+  /// @brief Canonical path (or another unique name of the source)
+  std::string path_;
+  std::size_t content_hash_{ 0 };
+
+  /// @brief Key of `file` (hashes its whole content)
+  static auto from_file(const std::filesystem::path& file) -> ResourceKey;
+  /// @brief Key of `file`, whose `content` has already been read
+  static auto from_content(const std::filesystem::path& file,
+                           std::string_view content) -> ResourceKey;
+
+  auto operator==(const ResourceKey& other) const -> bool
+  {
+    return content_hash_ == other.content_hash_ and path_ == other.path_;
+  }
+};
+
+struct ResourceKeyHash
+{
+  auto operator()(const ResourceKey& key) const -> std::size_t
+  {
+    return std::hash<std::string>{}(key.path_) ^ (key.content_hash_ << 1);
+  }
+};
+
+/**
+ * @brief Process-wide, thread-safe cache of shared resources
+ *
+ * The cache does not own its resources: it only tracks resources, that are
+ * still owned by someone (e.g. a level), so that loading the same file again
+ * returns the very same instance. Resources are released when their last
+ * owner is gone.
+ *
+ * @note As the last owner destroys the resource, GL resources must only be
+ * obtained (`find()`) on the thread owning GL context.
+ */
+template<typename T>
+class ResourceCache
+{
+public:
+  struct Statistics
+  {
+    unsigned hits_{ 0 };
+    unsigned misses_{ 0 };
+  };
+
+  static auto get() -> ResourceCache&
+  {
+    static ResourceCache cache;
+    return cache;
+  }
+
+  /// @brief Resident resource or nullptr
+  auto find(const ResourceKey& key) -> std::shared_ptr<T>
+  {
+    std::lock_guard lock{ mutex_ };
+    auto resource = lookup(key);
+    if (resource) {
+      statistics_.hits_++;
+    } else {
+      statistics_.misses_++;
+    }
+    return resource;
+  }
+
+  /// @brief Test residency without taking ownership
+  auto contains(const ResourceKey& key) const -> bool
+  {
+    std::lock_guard lock{ mutex_ };
+    const auto iterator = resources_.find(key);
+    return iterator != resources_.end() and not iterator->second.expired();
+  }
+
+  /// @brief Track `resource` (returns the resident one, if inserted meanwhile)
+  auto insert(const ResourceKey& key, std::shared_ptr<T> resource)
+    -> std::shared_ptr<T>
+  {
+    std::lock_guard lock{ mutex_ };
+    if (auto resident = lookup(key)) {
+      return resident;
+    }
+    collect_expired();
+    resources_[key] = resource;
+    return resource;
+  }
+
+  /// @brief Count of resident resources
+  auto get_size() const -> std::size_t
+  {
+    std::lock_guard lock{ mutex_ };
+    std::size_t result = 0;
+    for (const auto& [key, resource] : resources_) {
+      result += resource.expired() ? 0 : 1;
+    }
+    return result;
+  }
+
+  auto get_statistics() const -> Statistics
+  {
+    std::lock_guard lock{ mutex_ };
+    return statistics_;
+  }
+
+private:
+  ResourceCache() = default;
+
+  auto lookup(const ResourceKey& key) const -> std::shared_ptr<T>
+  {
+    const auto iterator = resources_.find(key);
+    return iterator == resources_.end() ? nullptr : iterator->second.lock();
+  }
+
+  auto collect_expired() -> void
+  {
+    for (auto it = resources_.begin(); it != resources_.end();) {
+      it = it->second.expired() ? resources_.erase(it) : std::next(it);
+    }
+  }
+
+  mutable std::mutex mutex_;
+  std::unordered_map<ResourceKey, std::weak_ptr<T>, ResourceKeyHash>
+    resources_;
+  Statistics statistics_;
+};
+
+} // namespace utils
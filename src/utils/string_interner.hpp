@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace utils {
+
+/**
+ * @brief Assigns a stable, dense index to each distinct string
+ *
+ * Indices are assigned in order of interning (starting at 0), so they can
+ * index arrays directly. Interned strings live as long as the interner.
+ * Thread-safe.
+ */
+class StringInterner
+{
+public:
+  using Index = std::uint32_t;
+
+  StringInterner() = default;
+  StringInterner(std::initializer_list<std::string_view> strings)
+  {
+    for (const auto string : strings) {
+      intern(string);
+    }
+  }
+
+  StringInterner(const StringInterner&) = delete;
+  StringInterner& operator=(const StringInterner&) = delete;
+
+  auto intern(std::string_view string) -> Index
+  {
+    std::lock_guard lock{ mutex_ };
+    if (const auto iterator = indices_.find(string);
+        iterator != indices_.end()) {
+      return iterator->second;
+    }
+    const auto index = static_cast<Index>(strings_.size());
+    // Deque keeps the strings in place, so views of them stay valid
+    const auto& stored = strings_.emplace_back(string);
+    indices_.emplace(stored, index);
+    return index;
+  }
+
+  auto get_string(Index index) const -> const std::string&
+  {
+    std::lock_guard lock{ mutex_ };
+    return strings_.at(index);
+  }
+
+  auto get_size() const -> std::size_t
+  {
+    std::lock_guard lock{ mutex_ };
+    return strings_.size();
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::deque<std::string> strings_;
+  std::unordered_map<std::string_view, Index> indices_;
+};
+
+} // namespace utils
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Fixed-size pool of worker threads, executing tasks in FIFO order
+ *
+ * Results (and exceptions) of tasks are delivered via `std::future`. Tasks,
+ * queued when the pool is destroyed, are still executed.
+ */
+class ThreadPool
+{
+public:
+  explicit ThreadPool(unsigned thread_count = default_thread_count())
+  {
+    for (unsigned i = 0; i < std::max(thread_count, 1u); i++) {
+      threads_.emplace_back([this]() { worker(); });
+    }
+  }
+
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard lock{ mutex_ };
+      is_stopping_ = true;
+    }
+    condition_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  template<typename Task>
+  auto submit(Task&& task) -> std::future<std::invoke_result_t<Task>>
+  {
+    using Result = std::invoke_result_t<Task>;
+    // std::function must be copyable, std::packaged_task is move-only
+    auto packaged_task =
+      std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+    auto result = packaged_task->get_future();
+    {
+      std::lock_guard lock{ mutex_ };
+      tasks_.emplace([packaged_task]() { (*packaged_task)(); });
+    }
+    condition_.notify_one();
+    return result;
+  }
+
+  auto get_thread_count() const -> unsigned
+  {
+    return static_cast<unsigned>(threads_.size());
+  }
+
+  static auto default_thread_count() -> unsigned
+  {
+    return std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+private:
+  auto worker() -> void
+  {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock lock{ mutex_ };
+        condition_.wait(lock,
+                        [this]() { return is_stopping_ or not tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> threads_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool is_stopping_{ false };
+};
+
+} // namespace utils
@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+
+#include <bm/event_distributor.hpp>
+#include <utils/metrics.hpp>
+
+namespace event_distributor_test {
+struct Ping
+{
+  int value;
+};
+
+struct Listener
+{
+  auto handle(const Ping& ping) -> void
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+    sum += ping.value;
+  }
+
+  int sum{ 0 };
+};
+} // namespace event_distributor_test
+
+TEST_CASE("bm::EventDistributor: latency metrics", "event_distributor")
+{
+  using event_distributor_test::Ping;
+  const auto labels = "type=\"event_distributor_test::Ping\"";
+  const utils::Histogram lateness{ "event_lateness_nanoseconds", labels };
+  const utils::Histogram handler_time{ "event_handler_nanoseconds", labels };
+
+  bm::EventDistributor distributor;
+  event_distributor_test::Listener listener;
+  distributor.registry_listener<Ping>(listener);
+
+  // Dispatched 5 ms after being due (e.g. a hitch)
+  const auto planned = bm::EventDistributor::Clock::now();
+  distributor.enqueue_event(Ping{ 1 }, planned);
+  distributor.enqueue_event(Ping{ 2 }, planned);
+  std::this_thread::sleep_for(std::chrono::milliseconds{ 5 });
+  distributor.dispatch();
+  REQUIRE(listener.sum == 3);
+
+  const auto lateness_snapshot = lateness.get_snapshot();
+  REQUIRE(lateness_snapshot.count_ == 2);
+  REQUIRE(lateness_snapshot.get_quantile(0.0) >= 5'000'000);
+
+  const auto handler_snapshot = handler_time.get_snapshot();
+  REQUIRE(handler_snapshot.count_ == 2);
+  REQUIRE(handler_snapshot.get_quantile(0.0) >= 1'000'000);
+
+  const auto backlog = utils::Histogram{ "event_backlog" }.get_snapshot();
+  REQUIRE(backlog.count_ >= 1);
+  REQUIRE(backlog.buckets_[2] >= 1);
+}
@@ -0,0 +1,182 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+
+#include <bm/interfaces/game.hpp>
+#include <bm/level.hpp>
+#include <bm/level_generator.hpp>
+#include <bm/simulation.hpp>
+#include <utils/json.hpp>
+
+namespace {
+auto
+get_indices(const render::TiledMap& map, const std::string& layer)
+  -> const std::vector<render::TiledMap::TileIndex>&
+{
+  return std::get<render::TiledMap::TileLayer>(map.get_layer(layer).data_)
+    .tile_indices_;
+}
+
+auto
+count_tiles(const render::TiledMap& map, const std::string& layer) -> long
+{
+  const auto& indices = get_indices(map, layer);
+  return std::count_if(indices.begin(), indices.end(), [](auto index) {
+    return index != render::TiledMap::invalid_index;
+  });
+}
+
+/// @brief Game of a generated level
+class GeneratedGame : public bm::interfaces::IGame
+{
+public:
+  explicit GeneratedGame(std::shared_ptr<render::TiledMap> map)
+    : level_{ bm::Level::Settings{} }
+  {
+    level_.map_ = std::move(map);
+  }
+
+  auto get_current_level() const -> const bm::Level* override
+  {
+    return &level_;
+  }
+
+private:
+  bm::Level level_;
+};
+} // namespace
+
+TEST_CASE("bm::LevelGenerator: layout", "level_generator")
+{
+  bm::LevelGenerator::Settings settings;
+  settings.width = 100;
+  settings.height = 60;
+  settings.crate_density = 0.5f;
+  settings.npc_density = 0.1f;
+  const auto map = bm::LevelGenerator::generate(settings);
+
+  REQUIRE(map->count_x == 100);
+  REQUIRE(map->count_y == 60);
+  REQUIRE_NOTHROW(map->validate());
+  REQUIRE(map->get_layer("boxes").visible_ == false);
+  REQUIRE(map->get_layer("npcs").visible_ == false);
+
+  // Walls on pillars only (all of them, except around spawn)
+  const auto& walls = get_indices(*map, "collisions");
+  for (unsigned y = 0; y < map->count_y; y++) {
+    for (unsigned x = 0; x < map->count_x; x++) {
+      const auto is_pillar = x % 2 == 1 and y % 2 == 1;
+      const auto tile = walls.at(y * map->count_x + x);
+      REQUIRE((tile == bm::LevelGenerator::wall_tile) ==
+              (is_pillar and glm::ivec2(x, y) != glm::ivec2(5, 1)));
+    }
+  }
+
+  // Crates & NPCs by their densities (of 4500 free cells)
+  const auto crates = count_tiles(*map, "boxes");
+  const auto npcs = count_tiles(*map, "npcs");
+  REQUIRE(crates > 2000);
+  REQUIRE(crates < 2500);
+  REQUIRE(npcs > 150);
+  REQUIRE(npcs < 300);
+
+  const auto spawn = glm::ivec2(bm::GameController::spawn_position);
+  const auto spawn_index = spawn.y * map->count_x + spawn.x;
+  REQUIRE(walls.at(spawn_index) == bm::LevelGenerator::floor_tile);
+  REQUIRE(get_indices(*map, "boxes").at(spawn_index) ==
+          render::TiledMap::invalid_index);
+
+  // Same seed, same level
+  REQUIRE(get_indices(*bm::LevelGenerator::generate(settings), "boxes") ==
+          get_indices(*map, "boxes"));
+  settings.seed++;
+  REQUIRE(get_indices(*bm::LevelGenerator::generate(settings), "boxes") !=
+          get_indices(*map, "boxes"));
+
+  settings.width = 4;
+  REQUIRE_THROWS(bm::LevelGenerator::generate(settings));
+}
+
+TEST_CASE("bm::LevelGenerator: densities out of range", "level_generator")
+{
+  bm::LevelGenerator::Settings settings;
+  settings.width = 16;
+  settings.height = 16;
+  REQUIRE_NOTHROW(bm::LevelGenerator::generate(settings));
+
+  auto wall = settings;
+  wall.wall_density = 1.5f;
+  REQUIRE_THROWS(bm::LevelGenerator::generate(wall));
+  auto crate = settings;
+  crate.crate_density = -0.1f;
+  REQUIRE_THROWS(bm::LevelGenerator::generate(crate));
+  auto npc = settings;
+  npc.npc_density = std::numeric_limits<float>::quiet_NaN();
+  REQUIRE_THROWS(bm::LevelGenerator::generate(npc));
+}
+
+TEST_CASE("bm::LevelGenerator: written level loads", "level_generator")
+{
+  const auto assets = std::filesystem::temp_directory_path() / "b0mb3rman_gen";
+  std::filesystem::create_directories(assets / "levels");
+  utils::write_json(assets / "tiles.json",
+                    { { "tilewidth", 8 }, { "tileheight", 8 } });
+
+  bm::LevelGenerator::Settings settings;
+  settings.width = 33;
+  settings.height = 17;
+  const auto level =
+    bm::LevelGenerator::write_level(settings,
+                                    assets,
+                                    "levels/stress.json",
+                                    bm::Level::Settings{ "tiles.json" });
+  REQUIRE(level.tilemap_path == "levels/stress.map.json");
+
+  const bm::Level::Settings read =
+    utils::read_json(assets / "levels/stress.json");
+  REQUIRE(read.tileset_name == "tiles.json");
+  REQUIRE(read.tilemap_path == level.tilemap_path);
+
+  const auto json = utils::read_json(assets / level.tilemap_path);
+  REQUIRE(json.at("tilesets").at(0).at("source") == "../tiles.json");
+
+  const auto generated = bm::LevelGenerator::generate(settings);
+  const auto loaded =
+    render::TiledMap::load_map(assets / level.tilemap_path, nullptr);
+  REQUIRE(loaded->count_x == 33);
+  REQUIRE(loaded->count_y == 17);
+  REQUIRE(loaded->layers_.size() == 3);
+  for (const auto& layer : generated->layers_) {
+    REQUIRE(loaded->get_layer(layer.name_).visible_ == layer.visible_);
+    REQUIRE(get_indices(*loaded, layer.name_) ==
+            get_indices(*generated, layer.name_));
+  }
+
+  std::filesystem::remove_all(assets);
+}
+
+TEST_CASE("bm::LevelGenerator: NPCs spawn by layer", "level_generator")
+{
+  bm::LevelGenerator::Settings settings;
+  settings.npc_density = 0.05f;
+  GeneratedGame game{ bm::LevelGenerator::generate(settings) };
+  const auto& map = *game.get_current_level()->map_;
+
+  bm::GameController::Texts texts;
+  bm::Simulation simulation{ game, texts, bm::Simulation::Settings{ true } };
+  simulation.load_static_collisions(map);
+  simulation.start();
+  simulation.tick();
+
+  long npcs = 0;
+  long crates = 0;
+  for (const auto& [id, entity] : simulation.world_) {
+    npcs += entity.get_type() == bm::Entity::Type::npc;
+    crates += entity.get_type() == bm::Entity::Type::crate;
+  }
+  REQUIRE(npcs == count_tiles(map, "npcs"));
+  REQUIRE(crates == count_tiles(map, "boxes"));
+  REQUIRE(npcs > 0);
+}
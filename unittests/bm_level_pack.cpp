@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <fstream>
+
+#include <bm/level_pack.hpp>
+
+namespace {
+auto
+make_tileset() -> render::Tileset::Decoded
+{
+  static const std::vector<gl::GLubyte> pixels = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16
+  };
+  render::Tileset::Decoded decoded;
+  decoded.tileset_ = std::make_shared<render::Tileset>();
+  decoded.tileset_->tile_size_x_ = 2;
+  decoded.tileset_->tile_size_y_ = 1;
+  decoded.tileset_->total_tiles_ = 2;
+  decoded.tileset_->transparent_color_ = utils::Color("#ff00ff");
+  decoded.tileset_->animations.resize(2);
+  decoded.tileset_->animations.at(1).sequence = {
+    { std::chrono::milliseconds{ 100 }, 0 },
+    { std::chrono::milliseconds{ 200 }, 1 }
+  };
+  decoded.image_.width_ = 2;
+  decoded.image_.height_ = 2;
+  decoded.image_.pixels_ = pixels.data();
+  return decoded;
+}
+} // namespace
+
+TEST_CASE("bm::LevelPack: round trip", "level_pack")
+{
+  const auto directory =
+    std::filesystem::temp_directory_path() / "b0mb3rman_level_pack";
+  std::filesystem::create_directories(directory);
+  const auto source = directory / "source.json";
+  const auto pack_path = directory / "level.pack";
+  std::ofstream{ source } << "{}";
+
+  bm::Level::Settings settings;
+  settings.tileset_name = "tiles.json";
+  settings.tilemap_path = "map.json";
+  settings.tilesets = { "fire.json" };
+
+  render::TiledMap map;
+  map.count_x = 2;
+  map.count_y = 2;
+  map.layers_.push_back(
+    { "ground", true, render::TiledMap::TileLayer{ { 0, 1, 1, 0 } } });
+  map.layers_.push_back({ "objects", false, render::TiledMap::ObjectLayer{} });
+
+  bm::LevelPack::write(
+    pack_path, { source }, settings, map, { { "default", make_tileset() } });
+
+  const auto pack = bm::LevelPack::open_if_fresh(pack_path);
+  REQUIRE(pack);
+  REQUIRE(pack->get_settings().tileset_name == "tiles.json");
+  REQUIRE(pack->get_settings().tilesets.size() == 1);
+
+  const auto& loaded_map = *pack->get_map();
+  REQUIRE(loaded_map.count_x == 2);
+  REQUIRE(loaded_map.layers_.size() == 2);
+  REQUIRE(loaded_map.layers_.at(0).name_ == "ground");
+  REQUIRE(std::get<render::TiledMap::TileLayer>(loaded_map.layers_.at(0).data_)
+            .tile_indices_ == std::vector<render::TiledMap::TileIndex>{
+                                0, 1, 1, 0 });
+  REQUIRE_FALSE(loaded_map.layers_.at(1).visible_);
+
+  REQUIRE(pack->get_tilesets().size() == 1);
+  const auto& [name, decoded] = pack->get_tilesets().at(0);
+  REQUIRE(name == "default");
+  REQUIRE(decoded.tileset_->tile_size_x_ == 2);
+  REQUIRE(decoded.tileset_->transparent_color_ == utils::Color("#ff00ff"));
+  REQUIRE(decoded.tileset_->animations.at(1).sequence.size() == 2);
+  REQUIRE(decoded.tileset_->animations.at(1).sequence.at(1).tile == 1);
+  REQUIRE(decoded.image_.width_ == 2);
+  REQUIRE(
+    std::memcmp(decoded.image_.pixels_, make_tileset().image_.pixels_, 16) == 0);
+
+  SECTION("palettized images")
+  {
+    auto tileset = make_tileset();
+    tileset.image_ = render::palettize_image(tileset.image_).value();
+    bm::LevelPack::write(
+      pack_path, { source }, settings, map, { { "default", tileset } });
+
+    const auto palettized = bm::LevelPack::open_if_fresh(pack_path);
+    REQUIRE(palettized);
+    const auto& image = palettized->get_tilesets().at(0).tileset_.image_;
+    REQUIRE(image.is_palettized());
+    REQUIRE(std::memcmp(image.pixels_, tileset.image_.pixels_, 4) == 0);
+    REQUIRE(std::memcmp(image.palette_, tileset.image_.palette_, 16) == 0);
+  }
+
+  SECTION("modified source makes the pack stale")
+  {
+    std::ofstream{ source } << "{ \"changed\": true }";
+    REQUIRE(pack->is_stale());
+    REQUIRE_FALSE(bm::LevelPack::open_if_fresh(pack_path));
+  }
+
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <functional>
+#include <map>
+
+#include <bm/interfaces/game.hpp>
+#include <bm/level.hpp>
+#include <bm/replay_journal.hpp>
+#include <bm/simulation.hpp>
+
+namespace {
+/// @brief Game of a walled map with pillars and crates
+class TestGame : public bm::interfaces::IGame
+{
+public:
+  static constexpr unsigned width = 16;
+  static constexpr unsigned height = 12;
+
+  TestGame()
+    : level_{ bm::Level::Settings{} }
+  {
+    render::TiledMap::TileLayer walls;
+    render::TiledMap::TileLayer boxes;
+    for (unsigned y = 0; y < height; y++) {
+      for (unsigned x = 0; x < width; x++) {
+        const auto is_pillar = x % 2 == 1 and y % 2 == 1;
+        walls.tile_indices_.push_back(is_pillar or y == height - 1 ? 1 : 0);
+        const auto is_box = not is_pillar and y == 2 and x > 3;
+        boxes.tile_indices_.push_back(
+          is_box ? 0 : render::TiledMap::invalid_index);
+      }
+    }
+    level_.map_ = std::make_shared<render::TiledMap>();
+    level_.map_->count_x = width;
+    level_.map_->count_y = height;
+    level_.map_->layers_.push_back({ "walls", true, walls });
+    level_.map_->layers_.push_back({ "boxes", true, boxes });
+  }
+
+  auto get_current_level() const -> const bm::Level* override
+  {
+    return &level_;
+  }
+
+private:
+  bm::Level level_;
+};
+
+using Direction = bm::event::PlayerMoved::MoveDirection;
+
+/// @brief Play a match with inputs at fixed ticks
+auto
+play(bm::Simulation& simulation) -> void
+{
+  const auto move = [&](Direction direction, bool is_pressed) {
+    return [&simulation, direction, is_pressed]() {
+      if (const auto id = simulation.world_.get_player_id()) {
+        simulation.submit(
+          bm::event::PlayerMoved{ { *id }, is_pressed, direction });
+      }
+    };
+  };
+  const auto plant_bomb = [&simulation]() {
+    if (const auto id = simulation.world_.get_player_id()) {
+      simulation.submit(bm::event::PlayerActionEvent{ { *id } });
+    }
+  };
+  const auto restart = [&simulation]() {
+    simulation.submit(bm::event::GameStarted{});
+  };
+
+  const std::map<unsigned, std::function<void()>> script{
+    { 10, move(Direction::down, true) },   { 40, move(Direction::down, false) },
+    { 45, plant_bomb },                    { 50, move(Direction::left, true) },
+    { 90, move(Direction::left, false) },  { 300, restart },
+    { 320, move(Direction::right, true) }, { 330, plant_bomb },
+    { 360, move(Direction::right, false) }
+  };
+
+  simulation.start();
+  for (unsigned tick = 0; tick < 600; tick++) {
+    if (const auto input = script.find(tick); input != script.end()) {
+      input->second();
+    }
+    simulation.tick();
+  }
+}
+} // namespace
+
+TEST_CASE("bm::Simulation: replay reaches the recorded state", "simulation")
+{
+  const auto journal_file =
+    std::filesystem::temp_directory_path() / "b0mb3rman_test.journal";
+
+  TestGame game;
+  bm::GameController::Texts texts;
+  std::uint64_t recorded_hash = 0;
+  {
+    bm::Simulation simulation{
+      game, texts, bm::Simulation::Settings{ true, 42, journal_file }
+    };
+    simulation.load_static_collisions(*game.get_current_level()->map_);
+    play(simulation);
+    REQUIRE(simulation.get_tick() == 300);
+    recorded_hash = simulation.compute_state_hash();
+  }
+
+  const auto journal = bm::ReplayJournal::read(journal_file);
+  REQUIRE(journal.seed_ == 42);
+  REQUIRE(journal.entries_.size() == 9);
+  REQUIRE(std::holds_alternative<bm::event::GameStarted>(
+    journal.entries_.at(5).input_));
+  REQUIRE(journal.final_tick_ == 300u);
+  REQUIRE(journal.final_state_hash_ == recorded_hash);
+
+  // Replays are identical (to each other and to the recording)
+  for (int i = 0; i < 2; i++) {
+    bm::Simulation replay{ game, texts, bm::Simulation::Settings{ true } };
+    replay.load_static_collisions(*game.get_current_level()->map_);
+    REQUIRE(replay.replay(journal) == recorded_hash);
+  }
+
+  std::filesystem::remove(journal_file);
+}
+
+TEST_CASE("bm::Simulation: recording requires fixed timestep", "simulation")
+{
+  TestGame game;
+  bm::GameController::Texts texts;
+  REQUIRE_THROWS(bm::Simulation{
+    game, texts, bm::Simulation::Settings{ false, 1, "never.journal" } });
+}
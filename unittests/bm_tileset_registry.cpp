@@ -0,0 +1,164 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <bm/tileset_registry.hpp>
+
+using bm::TilesetHandle;
+
+namespace {
+/// @brief Tileset with a (fake) resident texture, so no upload happens
+auto
+make_tileset(std::size_t texture_size) -> std::shared_ptr<render::Tileset>
+{
+  auto tileset = std::make_shared<render::Tileset>();
+  tileset->texture_ = std::make_shared<const render::Texture>();
+  tileset->texture_size_ = texture_size;
+  return tileset;
+}
+
+/// @brief Loads, finished by tests
+struct PendingLoads
+{
+  auto get_load_function() -> bm::TilesetRegistry::LoadFunction
+  {
+    return [this](const std::string& name) {
+      return promises_[name].get_future();
+    };
+  }
+
+  auto finish(const std::string& name, std::size_t texture_size) -> void
+  {
+    promises_.at(name).set_value(
+      render::Tileset::Decoded{ make_tileset(texture_size) });
+  }
+
+  std::map<std::string, std::promise<render::Tileset::Decoded>> promises_;
+};
+} // namespace
+
+TEST_CASE("bm::TilesetRegistry: loads on first use", "tileset_registry")
+{
+  bm::TilesetRegistry registry;
+  const auto fallback = make_tileset(10);
+  registry.insert(TilesetHandle{ "default" }, fallback, true);
+
+  PendingLoads loads;
+  registry.set_load_function(loads.get_load_function());
+
+  REQUIRE(registry.acquire(TilesetHandle{ "fire.json" }) == fallback.get());
+  REQUIRE(registry.acquire(TilesetHandle{ "fire.json" }) == fallback.get());
+  REQUIRE(loads.promises_.size() == 1);
+  REQUIRE_FALSE(registry.find(TilesetHandle{ "fire.json" }));
+  REQUIRE(registry.get(TilesetHandle{ "fire.json" }) == nullptr);
+
+  loads.finish("fire.json", 20);
+  registry.update();
+  REQUIRE(registry.find(TilesetHandle{ "fire.json" }));
+  REQUIRE(registry.get(TilesetHandle{ "fire.json" }) ==
+          registry.find(TilesetHandle{ "fire.json" }).get());
+  REQUIRE(registry.acquire(TilesetHandle{ "fire.json" }) != fallback.get());
+  REQUIRE(registry.get_memory_usage() == 30);
+}
+
+TEST_CASE("bm::TilesetRegistry: failures fall back", "tileset_registry")
+{
+  bm::TilesetRegistry registry;
+  const auto fallback = make_tileset(10);
+  registry.insert(TilesetHandle{ "default" }, fallback, true);
+
+  SECTION("without load function")
+  {
+    REQUIRE(registry.acquire(TilesetHandle{ "missing.json" }) ==
+            fallback.get());
+  }
+
+  SECTION("failed load is not retried")
+  {
+    PendingLoads loads;
+    registry.set_load_function(loads.get_load_function());
+    registry.acquire(TilesetHandle{ "broken.json" });
+    loads.promises_.at("broken.json")
+      .set_exception(std::make_exception_ptr(std::runtime_error("broken")));
+    registry.update();
+
+    loads.promises_.clear();
+    REQUIRE(registry.acquire(TilesetHandle{ "broken.json" }) == fallback.get());
+    REQUIRE(loads.promises_.empty());
+  }
+}
+
+TEST_CASE("bm::TilesetRegistry: evicts unused tilesets over budget",
+          "tileset_registry")
+{
+  bm::TilesetRegistry registry{ 100 };
+  registry.insert(TilesetHandle{ "default" }, make_tileset(60), true);
+  registry.insert(TilesetHandle{ "a.json" }, make_tileset(30), false);
+  registry.insert(TilesetHandle{ "b.json" }, make_tileset(30), false);
+
+  // Just inserted tilesets are kept for a frame
+  registry.update();
+  REQUIRE(registry.get_memory_usage() == 120);
+
+  // Only "b" is drawn
+  registry.acquire(TilesetHandle{ "b.json" });
+  registry.update();
+  REQUIRE_FALSE(registry.find(TilesetHandle{ "a.json" }));
+  REQUIRE(registry.find(TilesetHandle{ "b.json" }));
+  REQUIRE(registry.find(TilesetHandle{ "default" }));
+  REQUIRE(registry.get_memory_usage() == 90);
+
+  // Nothing is drawn: pinned tileset stays
+  registry.set_memory_budget(0);
+  registry.update();
+  REQUIRE_FALSE(registry.find(TilesetHandle{ "b.json" }));
+  REQUIRE(registry.find(TilesetHandle{ "default" }));
+  REQUIRE(registry.get_memory_usage() == 60);
+  REQUIRE(registry.get_resident() == std::vector{ TilesetHandle{} });
+}
+
+TEST_CASE("bm::TilesetRegistry: insert while loading", "tileset_registry")
+{
+  bm::TilesetRegistry registry;
+  registry.insert(TilesetHandle{ "default" }, make_tileset(10), true);
+  PendingLoads loads;
+  registry.set_load_function(loads.get_load_function());
+  registry.acquire(TilesetHandle{ "fire.json" });
+
+  // E.g. reloaded, before the load finishes
+  const auto inserted = make_tileset(30);
+  registry.insert(TilesetHandle{ "fire.json" }, inserted, false);
+  loads.finish("fire.json", 20);
+  registry.update();
+
+  REQUIRE(registry.get(TilesetHandle{ "fire.json" }) == inserted.get());
+  REQUIRE(registry.get_memory_usage() == 40);
+}
+
+TEST_CASE("bm::TilesetRegistry: acquired tilesets outlive growth",
+          "tileset_registry")
+{
+  bm::TilesetRegistry registry;
+  const auto fire = make_tileset(10);
+  registry.insert(TilesetHandle{ "fire.json" }, fire, true);
+  const auto* acquired = registry.acquire(TilesetHandle{ "fire.json" });
+
+  // Acquiring new handles grows entries of the registry
+  for (int i = 0; i < 100; i++) {
+    registry.acquire(TilesetHandle{ "growth" + std::to_string(i) + ".json" });
+  }
+  REQUIRE(acquired == fire.get());
+  REQUIRE(registry.acquire(TilesetHandle{ "fire.json" }) == acquired);
+}
+
+TEST_CASE("bm::TilesetHandle: interning", "tileset_registry")
+{
+  REQUIRE(TilesetHandle{}.is_default());
+  REQUIRE(TilesetHandle{ "default" } == TilesetHandle{});
+  REQUIRE(TilesetHandle{ "fire.json" } == TilesetHandle{ "fire.json" });
+  REQUIRE(TilesetHandle{ "fire.json" } != TilesetHandle{ "bomb.json" });
+  REQUIRE(TilesetHandle{ "fire.json" }.get_name() == "fire.json");
+}
@@ -0,0 +1,43 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+
+#include <render/frame_pacer.hpp>
+
+using Clock = render::FramePacer::Clock;
+
+TEST_CASE("render::FramePacer: unlimited", "frame_pacer")
+{
+  render::FramePacer pacer;
+  const auto begin = Clock::now();
+  for (int i = 0; i < 1000; i++) {
+    pacer.wait();
+  }
+  REQUIRE(Clock::now() - begin < std::chrono::milliseconds{ 100 });
+}
+
+TEST_CASE("render::FramePacer: target FPS", "frame_pacer")
+{
+  // First frame is due immediately, the others each 5 ms
+  const auto begin = Clock::now();
+  render::FramePacer pacer{ 200 };
+  REQUIRE(pacer.get_target_fps() == 200);
+  for (int i = 0; i < 21; i++) {
+    pacer.wait();
+  }
+  const auto elapsed = Clock::now() - begin;
+  REQUIRE(elapsed >= std::chrono::milliseconds{ 100 });
+  REQUIRE(elapsed < std::chrono::milliseconds{ 400 });
+}
+
+TEST_CASE("render::FramePacer: hitch restarts cadence", "frame_pacer")
+{
+  render::FramePacer pacer{ 100 };
+  pacer.wait();
+  // A hitch of 5 frames is not caught up by rushing the next ones
+  std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+  pacer.wait();
+  const auto begin = Clock::now();
+  pacer.wait();
+  REQUIRE(Clock::now() - begin >= std::chrono::milliseconds{ 9 });
+}
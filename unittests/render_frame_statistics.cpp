@@ -0,0 +1,55 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <render/frame_statistics.hpp>
+
+using std::chrono::microseconds;
+
+TEST_CASE("render::FrameStatistics: percentiles", "frame_statistics")
+{
+  render::FrameStatistics statistics{ 100 };
+  REQUIRE(statistics.get_summary().count_ == 0);
+
+  // 90 frames of 10 ms, 9 of 20 ms and a 50 ms hitch
+  for (int i = 0; i < 90; i++) {
+    statistics.record(microseconds{ 10000 });
+  }
+  for (int i = 0; i < 9; i++) {
+    statistics.record(microseconds{ 20000 });
+  }
+  statistics.record(microseconds{ 50000 });
+
+  const auto summary = statistics.get_summary();
+  REQUIRE(summary.count_ == 100);
+  REQUIRE(summary.mean_ == microseconds{ 11300 });
+  REQUIRE(summary.max_ == microseconds{ 50000 });
+  // Percentiles are upper bounds of buckets (within 12.5 %)
+  REQUIRE(summary.p50_ >= microseconds{ 10000 });
+  REQUIRE(summary.p50_ <= microseconds{ 11250 });
+  REQUIRE(summary.p95_ >= microseconds{ 20000 });
+  REQUIRE(summary.p95_ <= microseconds{ 22500 });
+  REQUIRE(summary.p99_ >= microseconds{ 20000 });
+  REQUIRE(summary.p99_ <= microseconds{ 22500 });
+}
+
+TEST_CASE("render::FrameStatistics: rolling window", "frame_statistics")
+{
+  render::FrameStatistics statistics{ 4 };
+  statistics.record(microseconds{ 100000 });
+  for (int i = 0; i < 4; i++) {
+    statistics.record(microseconds{ 1000 });
+  }
+
+  // The hitch has left the window
+  auto summary = statistics.get_summary();
+  REQUIRE(summary.count_ == 4);
+  REQUIRE(summary.mean_ == microseconds{ 1000 });
+  REQUIRE(summary.max_ == microseconds{ 1000 });
+  REQUIRE(summary.p99_ < microseconds{ 1200 });
+
+  statistics.clear();
+  REQUIRE(statistics.get_summary().count_ == 0);
+  statistics.record(microseconds{ 2000 });
+  REQUIRE(statistics.get_summary().max_ == microseconds{ 2000 });
+
+  REQUIRE_THROWS(render::FrameStatistics{ 0 });
+}
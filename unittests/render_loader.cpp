@@ -0,0 +1,57 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <vector>
+
+#include <render/loader.hpp>
+
+namespace {
+auto
+make_image(const std::vector<gl::GLubyte>& pixels, unsigned width)
+  -> render::ImageData
+{
+  render::ImageData image;
+  image.width_ = width;
+  image.height_ = static_cast<unsigned>(pixels.size() / 4 / width);
+  image.format_ = gl::GL_BGRA;
+  image.pixels_ = pixels.data();
+  return image;
+}
+} // namespace
+
+TEST_CASE("render::palettize_image: few colors", "loader")
+{
+  const std::vector<gl::GLubyte> pixels = {
+    1, 2, 3, 255, 4, 5, 6, 0, // row 0
+    4, 5, 6, 0,   1, 2, 3, 255 // row 1
+  };
+  const auto image = render::palettize_image(make_image(pixels, 2));
+  REQUIRE(image);
+  REQUIRE(image->is_palettized());
+  REQUIRE(image->get_pixels_size() == 4);
+
+  const auto* indices = image->pixels_;
+  REQUIRE(indices[0] == indices[3]);
+  REQUIRE(indices[1] == indices[2]);
+  REQUIRE(indices[0] != indices[1]);
+
+  // Palette is RGBA, source was BGRA
+  const auto* first = image->palette_ + indices[0] * 4;
+  REQUIRE(std::vector<gl::GLubyte>(first, first + 4) ==
+          std::vector<gl::GLubyte>{ 3, 2, 1, 255 });
+}
+
+TEST_CASE("render::palettize_image: too many colors", "loader")
+{
+  std::vector<gl::GLubyte> pixels;
+  for (unsigned i = 0; i < 257; i++) {
+    pixels.insert(pixels.end(),
+                  { static_cast<gl::GLubyte>(i),
+                    static_cast<gl::GLubyte>(i >> 8),
+                    0,
+                    255 });
+  }
+  REQUIRE_FALSE(render::palettize_image(make_image(pixels, 257)));
+  pixels.resize(256 * 4);
+  REQUIRE(render::palettize_image(make_image(pixels, 256)));
+}
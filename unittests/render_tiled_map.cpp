@@ -0,0 +1,167 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <fstream>
+
+#include <render/tiled_map.hpp>
+
+namespace {
+auto
+load_map_from_string(const std::string& json)
+  -> std::shared_ptr<render::TiledMap>
+{
+  const auto path =
+    std::filesystem::temp_directory_path() / "b0mb3rman_tiled_map.json";
+  std::ofstream{ path } << json;
+  auto map = render::TiledMap::load_map(path, nullptr);
+  std::filesystem::remove(path);
+  return map;
+}
+
+auto
+get_indices(const render::TiledMap& map, std::size_t layer)
+  -> const std::vector<render::TiledMap::TileIndex>&
+{
+  return std::get<render::TiledMap::TileLayer>(map.layers_.at(layer).data_)
+    .tile_indices_;
+}
+
+constexpr auto invalid = render::TiledMap::invalid_index;
+} // namespace
+
+TEST_CASE("render::TiledMap: CSV layers", "tiled_map")
+{
+  const auto map = load_map_from_string(R"({
+    "height": 2,
+    "layers": [
+      { "data": [1, 0, 3, 2], "height": 2, "name": "ground",
+        "properties": [{ "name": "width", "value": 7 }],
+        "type": "tilelayer", "visible": true, "width": 2 },
+      { "name": "objects", "objects": [{ "id": 1, "width": 5 }],
+        "type": "objectgroup", "visible": false }
+    ],
+    "tilesets": [{ "firstgid": 1, "name": "width" }],
+    "width": 2
+  })");
+
+  REQUIRE(map->count_x == 2);
+  REQUIRE(map->count_y == 2);
+  REQUIRE(map->layers_.size() == 2);
+  REQUIRE(map->layers_.at(0).name_ == "ground");
+  REQUIRE(map->layers_.at(0).visible_);
+  REQUIRE(get_indices(*map, 0) ==
+          std::vector<render::TiledMap::TileIndex>{ 0, invalid, 2, 1 });
+
+  REQUIRE(map->layers_.at(1).name_ == "objects");
+  REQUIRE_FALSE(map->layers_.at(1).visible_);
+  REQUIRE(std::holds_alternative<render::TiledMap::ObjectLayer>(
+    map->layers_.at(1).data_));
+  REQUIRE_NOTHROW(map->validate());
+}
+
+TEST_CASE("render::TiledMap: sizes following layers' data", "tiled_map")
+{
+  // Key order of Tiled's output (alphabetical)
+  const auto map = load_map_from_string(R"({
+    "height": 2,
+    "layers": [
+      { "data": [1, 2, 3, 4, 5, 6], "height": 2, "name": "ground",
+        "type": "tilelayer", "visible": true, "width": 3 }
+    ],
+    "width": 3
+  })");
+
+  REQUIRE(map->count_x == 3);
+  REQUIRE(map->count_y == 2);
+  REQUIRE(get_indices(*map, 0).size() == 6);
+  REQUIRE(get_indices(*map, 0).capacity() == 6);
+  REQUIRE_NOTHROW(map->validate());
+
+  REQUIRE_THROWS(load_map_from_string(R"({
+    "height": 2,
+    "layers": [
+      { "data": [1, 2, 3], "height": 2, "name": "ground",
+        "type": "tilelayer", "visible": true, "width": 3 }
+    ],
+    "width": 3
+  })"));
+}
+
+TEST_CASE("render::TiledMap: missing required keys", "tiled_map")
+{
+  const auto* layer = R"({ "data": [1, 2], "name": "ground",
+                           "type": "tilelayer", "visible": true })";
+  const auto load = [](const std::string& layers, const std::string& size) {
+    return load_map_from_string(R"({ "layers": [)" + layers + "], " + size +
+                                " }");
+  };
+  const auto* size = R"("height": 1, "width": 2)";
+  REQUIRE_NOTHROW(load(layer, size));
+
+  // Map's
+  REQUIRE_THROWS(load(layer, R"("width": 2)"));
+  REQUIRE_THROWS(load(layer, R"("height": 1)"));
+  REQUIRE_THROWS(load_map_from_string(size));
+
+  // Layer's
+  REQUIRE_THROWS(load(R"({ "data": [1, 2], "type": "tilelayer",
+                           "visible": true })",
+                      size));
+  REQUIRE_THROWS(load(R"({ "data": [1, 2], "name": "ground",
+                           "type": "tilelayer" })",
+                      size));
+  REQUIRE_THROWS(load(R"({ "data": [1, 2], "name": "ground",
+                           "visible": true })",
+                      size));
+  REQUIRE_THROWS(load(R"({ "name": "ground", "type": "tilelayer",
+                           "visible": true })",
+                      size));
+  // Object layers have no data
+  REQUIRE_NOTHROW(load(R"({ "name": "objects", "type": "objectgroup",
+                            "visible": true })",
+                       size));
+
+  // Tile layers of other size than the map's
+  REQUIRE_THROWS(load(R"({ "data": [1], "name": "ground",
+                           "type": "tilelayer", "visible": true })",
+                      size));
+}
+
+TEST_CASE("render::TiledMap: base64 layers", "tiled_map")
+{
+  // GIDs [1, 0, 3, 2] as 32-bit little-endian integers
+  const auto expected =
+    std::vector<render::TiledMap::TileIndex>{ 0, invalid, 2, 1 };
+
+  SECTION("uncompressed")
+  {
+    const auto map = load_map_from_string(R"({
+      "height": 2, "width": 2,
+      "layers": [{ "data": "AQAAAAAAAAADAAAAAgAAAA==", "encoding": "base64",
+                   "height": 2, "name": "ground", "type": "tilelayer",
+                   "visible": true, "width": 2 }]
+    })");
+    REQUIRE(get_indices(*map, 0) == expected);
+  }
+
+  SECTION("zlib")
+  {
+    const auto map = load_map_from_string(R"({
+      "height": 2, "width": 2,
+      "layers": [{ "compression": "zlib",
+                   "data": "eJxjZIAAZiBmAmIAAEAABw==",
+                   "encoding": "base64", "height": 2, "name": "ground",
+                   "type": "tilelayer", "visible": true, "width": 2 }]
+    })");
+    REQUIRE(get_indices(*map, 0) == expected);
+  }
+
+  SECTION("unsupported compression")
+  {
+    REQUIRE_THROWS(load_map_from_string(R"({
+      "height": 1, "width": 1,
+      "layers": [{ "compression": "zstd", "data": "AQAAAA==",
+                   "encoding": "base64", "name": "ground",
+                   "type": "tilelayer", "visible": true }]
+    })"));
+  }
+}
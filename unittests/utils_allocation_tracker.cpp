@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <utils/allocation_tracker.hpp>
+#include <utils/profiler.hpp>
+
+namespace {
+/// @brief Allocations are kept alive (so they can't be elided)
+std::vector<std::unique_ptr<char[]>> allocated;
+
+auto
+allocate(std::size_t count, std::size_t size) -> void
+{
+  allocated.reserve(allocated.size() + count);
+  for (std::size_t i = 0; i < count; i++) {
+    allocated.push_back(std::make_unique<char[]>(size));
+  }
+}
+} // namespace
+
+TEST_CASE("utils::AllocationTracker: counts allocations of calling thread",
+          "allocation_tracker")
+{
+  using utils::AllocationTracker;
+  const auto begin = AllocationTracker::get_thread_counters();
+  allocate(3, 100);
+  const auto allocations = AllocationTracker::get_thread_counters() - begin;
+
+  if (AllocationTracker::is_enabled) {
+    // Vector's storage included
+    REQUIRE(allocations.allocations_ >= 3);
+    REQUIRE(allocations.bytes_ >= 300);
+  } else {
+    REQUIRE(allocations.allocations_ == 0);
+    REQUIRE(allocations.bytes_ == 0);
+  }
+
+  // Other threads' allocations are theirs
+  const auto before_thread = AllocationTracker::get_thread_counters();
+  AllocationTracker::Counters thread_allocations;
+  std::thread{ [&thread_allocations]() {
+    auto kept = std::make_unique<std::vector<int>>(1000);
+    thread_allocations = AllocationTracker::get_thread_counters();
+  } }.join();
+  if (AllocationTracker::is_enabled) {
+    REQUIRE(thread_allocations.allocations_ >= 2);
+    REQUIRE(thread_allocations.bytes_ >= 1000 * sizeof(int));
+  }
+  // Launch of the thread allocates in this thread, but not the vector
+  REQUIRE((AllocationTracker::get_thread_counters() - before_thread).bytes_ <
+          1000 * sizeof(int));
+  allocated.clear();
+}
+
+TEST_CASE("utils::AllocationBudget: steady frames within budget",
+          "allocation_tracker")
+{
+  utils::AllocationBudget budget{ 2, 1 };
+  allocated.reserve(16);
+
+  // Warm-up frame isn't checked
+  allocate(8, 16);
+  budget.end_frame();
+  REQUIRE(budget.get_checked_frames() == 0);
+
+  budget.end_frame();
+  allocate(1, 16);
+  budget.end_frame();
+  REQUIRE(budget.get_checked_frames() == 2);
+  REQUIRE_FALSE(budget.is_exceeded());
+
+  allocate(4, 16);
+  budget.end_frame();
+  REQUIRE(budget.get_checked_frames() == 3);
+  if (utils::AllocationTracker::is_enabled) {
+    REQUIRE(budget.get_exceeded_frames() == 1);
+    REQUIRE(budget.get_worst_frame().allocations_ == 4);
+    REQUIRE(budget.get_worst_frame().bytes_ == 4 * 16);
+  } else {
+    REQUIRE_FALSE(budget.is_exceeded());
+  }
+  allocated.clear();
+}
+
+TEST_CASE("utils::Profiler: allocations of zones", "allocation_tracker")
+{
+  auto& profiler = utils::Profiler::get();
+  static const char* const outer = "test: allocating outer";
+  static const char* const inner = "test: allocating inner";
+  allocated.reserve(16);
+  {
+    // Thread's first zone allocates its buffer (after zone's end)
+    const utils::Profiler::Zone zone{ inner };
+  }
+  profiler.end_frame();
+  {
+    const utils::Profiler::Zone outer_zone{ outer };
+    allocate(2, 32);
+    const utils::Profiler::Zone inner_zone{ inner };
+    allocate(3, 32);
+  }
+  profiler.end_frame();
+
+  const auto statistics = profiler.get_statistics();
+  auto find_zone = [&statistics](const char* name) {
+    for (const auto& zone : statistics) {
+      if (zone.name_ == name) {
+        return zone;
+      }
+    }
+    FAIL("Missing zone " << name);
+    return statistics.front();
+  };
+  // Nested zones' allocations are included
+  const auto expected_outer = utils::AllocationTracker::is_enabled ? 5 : 0;
+  const auto expected_inner = utils::AllocationTracker::is_enabled ? 3 : 0;
+  REQUIRE(find_zone(outer).maximum_allocations_ == expected_outer);
+  REQUIRE(find_zone(inner).maximum_allocations_ == expected_inner);
+  allocated.clear();
+}
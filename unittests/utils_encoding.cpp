@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include <zlib.h>
+
+#include <utils/encoding.hpp>
+
+namespace {
+auto
+to_bytes(const std::string& text) -> std::vector<std::uint8_t>
+{
+  return { text.begin(), text.end() };
+}
+} // namespace
+
+TEST_CASE("utils::decode_base64: basic", "encoding")
+{
+  REQUIRE(utils::decode_base64("").empty());
+  REQUIRE(utils::decode_base64("TWFu") == to_bytes("Man"));
+  REQUIRE(utils::decode_base64("TWE=") == to_bytes("Ma"));
+  REQUIRE(utils::decode_base64("TQ==") == to_bytes("M"));
+  REQUIRE(utils::decode_base64(" TW\nFu ") == to_bytes("Man"));
+  REQUIRE_THROWS(utils::decode_base64("T!Fu"));
+}
+
+TEST_CASE("utils::encode_base64: round trip", "encoding")
+{
+  REQUIRE(utils::encode_base64({}).empty());
+  REQUIRE(utils::encode_base64(to_bytes("Man")) == "TWFu");
+  REQUIRE(utils::encode_base64(to_bytes("Ma")) == "TWE=");
+  REQUIRE(utils::encode_base64(to_bytes("M")) == "TQ==");
+
+  std::vector<std::uint8_t> bytes;
+  for (unsigned i = 0; i < 1000; i++) {
+    bytes.push_back(static_cast<std::uint8_t>(i * 7));
+  }
+  REQUIRE(utils::decode_base64(utils::encode_base64(bytes)) == bytes);
+}
+
+TEST_CASE("utils::inflate: zlib stream", "encoding")
+{
+  const auto input = to_bytes(std::string(10000, 'x') + "tail");
+
+  std::vector<std::uint8_t> compressed(::compressBound(input.size()));
+  auto compressed_size = static_cast<::uLongf>(compressed.size());
+  REQUIRE(::compress(compressed.data(),
+                     &compressed_size,
+                     input.data(),
+                     input.size()) == Z_OK);
+  compressed.resize(compressed_size);
+
+  REQUIRE(utils::inflate(compressed) == input);
+  REQUIRE(utils::inflate(compressed, input.size()) == input);
+
+  compressed.resize(compressed.size() / 2);
+  REQUIRE_THROWS(utils::inflate(compressed));
+}
+
+TEST_CASE("utils::deflate: round trip", "encoding")
+{
+  const auto input = to_bytes(std::string(10000, 'x') + "tail");
+  const auto compressed = utils::deflate(input);
+  REQUIRE(compressed.size() < input.size());
+  REQUIRE(utils::inflate(compressed) == input);
+  REQUIRE(utils::inflate(utils::deflate({})).empty());
+}
@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <fstream>
+
+#include <utils/file_watcher.hpp>
+
+namespace {
+auto
+write_file(const std::filesystem::path& path, const std::string& content)
+  -> void
+{
+  std::ofstream{ path, std::ios::binary } << content;
+}
+} // namespace
+
+TEST_CASE("utils::FileWatcher: reports modified files", "file_watcher")
+{
+  const auto directory =
+    std::filesystem::temp_directory_path() / "b0mb3rman_file_watcher";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory / "existing");
+
+  utils::FileWatcher watcher{ directory };
+  REQUIRE(watcher.poll().empty());
+
+  SECTION("file in watched directory")
+  {
+    write_file(directory / "a.json", "{}");
+    write_file(directory / "a.json", "{ }");
+    const auto changes = watcher.poll();
+    REQUIRE(changes == std::vector{ directory / "a.json" });
+    REQUIRE(watcher.poll().empty());
+  }
+
+  SECTION("file in existing subdirectory")
+  {
+    write_file(directory / "existing" / "b.png", "png");
+    REQUIRE(watcher.poll() ==
+            std::vector{ directory / "existing" / "b.png" });
+  }
+
+  SECTION("file in new subdirectory")
+  {
+    std::filesystem::create_directory(directory / "new");
+    REQUIRE(watcher.poll().empty());
+    write_file(directory / "new" / "c.glsl", "void main() {}");
+    REQUIRE(watcher.poll() == std::vector{ directory / "new" / "c.glsl" });
+  }
+
+  SECTION("subdirectory removed before it's watched")
+  {
+    std::filesystem::create_directory(directory / "temporary");
+    std::filesystem::remove(directory / "temporary");
+    write_file(directory / "d.json", "{}");
+    REQUIRE(watcher.poll() == std::vector{ directory / "d.json" });
+  }
+
+  SECTION("file moved into directory")
+  {
+    const auto temporary = std::filesystem::temp_directory_path() / "moved";
+    write_file(temporary, "moved");
+    std::filesystem::rename(temporary, directory / "moved.json");
+    REQUIRE(watcher.poll() == std::vector{ directory / "moved.json" });
+  }
+
+  std::filesystem::remove_all(directory);
+}
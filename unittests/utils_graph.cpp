@@ -110,3 +110,27 @@ TEST_CASE("utils::Graph: oriented graph", "graph")
   REQUIRE_FALSE(graph.get_neighbours(2).count(1));
   REQUIRE_FALSE(graph.get_neighbours(2).count(2));
 }
+
+TEST_CASE("utils::Graph: edges of a grid don't collide", "graph")
+{
+  const utils::detail::pair_hash hash;
+  // Self-loops & reversed edges used to hash to 0 & to the same value
+  REQUIRE(hash(std::make_pair(1u, 1u)) != hash(std::make_pair(2u, 2u)));
+  REQUIRE(hash(std::make_pair(1u, 2u)) != hash(std::make_pair(2u, 1u)));
+  REQUIRE(utils::hash_combine(1, 2) != utils::hash_combine(2, 1));
+
+  utils::UnorientedGraph<> graph;
+  const unsigned side = 64;
+  for (unsigned node = 0; node < side * side; node++) {
+    graph.add_edge(node, node);
+    graph.add_edge(node, node + 1);
+    graph.add_edge(node, node + side);
+  }
+  const auto& edges = graph.get_edges();
+  std::size_t largest_bucket = 0;
+  for (std::size_t bucket = 0; bucket < edges.bucket_count(); bucket++) {
+    largest_bucket = std::max(largest_bucket, edges.bucket_size(bucket));
+  }
+  REQUIRE(edges.size() == 3 * side * side);
+  REQUIRE(largest_bucket < 16);
+}
@@ -224,6 +224,30 @@ TEST_CASE("utils::GraphAlgorithms: : compute_path: empty ", "graph")
   }
 }
 
+TEST_CASE("utils::GraphAlgorithms: : compute_path: grid", "graph")
+{
+  // 4x4 grid: vertices are reached via several paths
+  utils::UnorientedGraph<> graph;
+  for (unsigned y = 0; y < 4; y++) {
+    for (unsigned x = 0; x < 4; x++) {
+      if (x + 1 < 4) {
+        graph.add_edge(x + y * 4, x + 1 + y * 4);
+      }
+      if (y + 1 < 4) {
+        graph.add_edge(x + y * 4, x + (y + 1) * 4);
+      }
+    }
+  }
+
+  const auto path = utils::graph_algorithms::compute_path(graph, 0u, 15u);
+  REQUIRE(path.size() == 7);
+  REQUIRE(path.front() == 0);
+  REQUIRE(path.back() == 15);
+  for (std::size_t i = 1; i < path.size(); i++) {
+    REQUIRE(graph.has_edge(path[i - 1], path[i]));
+  }
+}
+
 TEST_CASE("utils::GraphAlgorithms: : strong components representative", "graph")
 {
   utils::OrientedGraph<> graph;
@@ -0,0 +1,62 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <fstream>
+
+#include <utils/io.hpp>
+#include <utils/json.hpp>
+#include <utils/mapped_file.hpp>
+
+namespace {
+auto
+write_temporary_file(const std::string& name, const std::string& content)
+  -> std::filesystem::path
+{
+  const auto path = std::filesystem::temp_directory_path() / name;
+  std::ofstream{ path, std::ios::binary } << content;
+  return path;
+}
+} // namespace
+
+TEST_CASE("utils::MappedFile: regular file", "mapped_file")
+{
+  const auto path =
+    write_temporary_file("b0mb3rman_mapped.txt", "hello\nmapped world");
+  {
+    const utils::MappedFile file{ path };
+    REQUIRE(file.is_mapped());
+    REQUIRE(file.get_size() == 18);
+    REQUIRE(file.get_view() == "hello\nmapped world");
+  }
+  REQUIRE(utils::read_text_file(path) == "hello\nmapped world");
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("utils::MappedFile: empty file", "mapped_file")
+{
+  const auto path = write_temporary_file("b0mb3rman_mapped_empty.txt", "");
+  const utils::MappedFile file{ path };
+  REQUIRE(file.get_size() == 0);
+  REQUIRE(file.get_view().empty());
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("utils::MappedFile: non-regular file falls back to read",
+          "mapped_file")
+{
+  const utils::MappedFile file{ "/proc/self/status" };
+  REQUIRE_FALSE(file.is_mapped());
+  REQUIRE(file.get_view().find("Name:") != std::string_view::npos);
+}
+
+TEST_CASE("utils::MappedFile: missing file", "mapped_file")
+{
+  REQUIRE_THROWS(utils::MappedFile{ "/nonexisting/b0mb3rman" });
+}
+
+TEST_CASE("utils::read_json: parses mapped content", "mapped_file")
+{
+  const auto path =
+    write_temporary_file("b0mb3rman_mapped.json", R"({ "a": [1, 2] })");
+  REQUIRE(utils::read_json(path).at("a").size() == 2);
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <utils/metrics.hpp>
+
+TEST_CASE("utils::Counter: shards of threads are merged", "metrics")
+{
+  const utils::Counter counter{ "test_merged_total" };
+  counter.increment(5);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&counter]() {
+      for (int j = 0; j < 1000; j++) {
+        counter.increment();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Counts of finished threads are kept
+  REQUIRE(counter.get_value() == 4005);
+}
+
+TEST_CASE("utils::MetricsRegistry: same name & labels is the same metric",
+          "metrics")
+{
+  const utils::Counter a{ "test_shared_total", "kind=\"a\"" };
+  const utils::Counter a_again{ "test_shared_total", "kind=\"a\"" };
+  const utils::Counter b{ "test_shared_total", "kind=\"b\"" };
+  a.increment();
+  a_again.increment();
+  b.increment();
+  REQUIRE(a.get_value() == 2);
+  REQUIRE(b.get_value() == 1);
+
+  REQUIRE_THROWS(utils::Gauge{ "test_shared_total", "kind=\"a\"" });
+}
+
+TEST_CASE("utils::MetricsRegistry: metrics are always registered", "metrics")
+{
+  // A default-constructed metric would write into another metric's slot
+  STATIC_REQUIRE_FALSE(std::is_default_constructible_v<utils::Counter>);
+  STATIC_REQUIRE_FALSE(std::is_default_constructible_v<utils::Gauge>);
+  STATIC_REQUIRE_FALSE(std::is_default_constructible_v<utils::Histogram>);
+}
+
+TEST_CASE("utils::Gauge", "metrics")
+{
+  const utils::Gauge gauge{ "test_gauge" };
+  gauge.set(10);
+  gauge.add(-3);
+  REQUIRE(gauge.get_value() == 7);
+}
+
+TEST_CASE("utils::Histogram: buckets", "metrics")
+{
+  using utils::Histogram;
+
+  // Exact below sub-bucket count, then within 12.5 %
+  REQUIRE(Histogram::get_bucket(0) == 0);
+  REQUIRE(Histogram::get_bucket(7) == 7);
+  REQUIRE(Histogram::get_bucket(8) == 8);
+  REQUIRE(Histogram::get_bucket(15) == 15);
+  REQUIRE(Histogram::get_bucket(16) == 16);
+  REQUIRE(Histogram::get_bucket(17) == 16);
+  REQUIRE(Histogram::get_bucket(~0ull) == Histogram::bucket_count - 1);
+
+  for (std::uint64_t value : { 1ull, 9ull, 100ull, 12345ull, 987654321ull }) {
+    const auto bucket = Histogram::get_bucket(value);
+    REQUIRE(value < Histogram::get_bucket_limit(bucket));
+    REQUIRE((bucket == 0 or value >= Histogram::get_bucket_limit(bucket - 1)));
+    REQUIRE(Histogram::get_bucket_limit(bucket) - value <= value / 8 + 1);
+  }
+}
+
+TEST_CASE("utils::Histogram: quantiles", "metrics")
+{
+  const utils::Histogram histogram{ "test_latency_nanoseconds" };
+  for (std::uint64_t value = 1; value <= 1000; value++) {
+    histogram.record(value);
+  }
+
+  const auto snapshot = histogram.get_snapshot();
+  REQUIRE(snapshot.count_ == 1000);
+  REQUIRE(snapshot.sum_ == 500500);
+
+  const auto median = snapshot.get_quantile(0.5);
+  REQUIRE(median >= 500);
+  REQUIRE(median <= 500 + 500 / 8);
+  REQUIRE(snapshot.get_quantile(1.0) >= 1000);
+}
+
+TEST_CASE("utils::MetricsRegistry: Prometheus text format", "metrics")
+{
+  utils::Counter{ "test_output_total", "type=\"x\"" }.increment(3);
+  utils::Histogram{ "test_output_nanoseconds" }.record(std::uint64_t{ 20 });
+
+  std::ostringstream output;
+  utils::MetricsRegistry::get().write_prometheus(output);
+  const auto text = output.str();
+
+  REQUIRE(text.find("# TYPE test_output_total counter\n") !=
+          std::string::npos);
+  REQUIRE(text.find("test_output_total{type=\"x\"} 3\n") != std::string::npos);
+  REQUIRE(text.find("# TYPE test_output_nanoseconds histogram\n") !=
+          std::string::npos);
+  REQUIRE(text.find("test_output_nanoseconds_bucket{le=\"21\"} 1\n") !=
+          std::string::npos);
+  REQUIRE(text.find("test_output_nanoseconds_bucket{le=\"+Inf\"} 1\n") !=
+          std::string::npos);
+  REQUIRE(text.find("test_output_nanoseconds_sum 20\n") != std::string::npos);
+  REQUIRE(text.find("test_output_nanoseconds_count 1\n") != std::string::npos);
+}
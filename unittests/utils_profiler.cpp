@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <thread>
+
+#include <utils/json.hpp>
+#include <utils/profiler.hpp>
+
+namespace {
+auto
+find_zone(const char* name) -> std::optional<utils::Profiler::ZoneStatistics>
+{
+  for (const auto& zone : utils::Profiler::get().get_statistics()) {
+    if (zone.name_ == name) {
+      return zone;
+    }
+  }
+  return std::nullopt;
+}
+
+/// @brief Zone of (at least) `duration`
+auto
+run_zone(const char* name, std::chrono::microseconds duration) -> void
+{
+  const utils::Profiler::Zone zone{ name };
+  std::this_thread::sleep_for(duration);
+}
+} // namespace
+
+TEST_CASE("utils::Profiler: rolling averages", "profiler")
+{
+  auto& profiler = utils::Profiler::get();
+  static const char* const name = "test: rolling";
+  profiler.end_frame();
+
+  // Zones of a frame are summed
+  run_zone(name, std::chrono::microseconds{ 500 });
+  run_zone(name, std::chrono::microseconds{ 500 });
+  profiler.end_frame();
+
+  const auto zone = find_zone(name);
+  REQUIRE(zone);
+  REQUIRE(zone->maximum_ >= std::chrono::milliseconds{ 1 });
+  REQUIRE(zone->average_ > std::chrono::nanoseconds{ 0 });
+  REQUIRE(zone->average_ <= zone->maximum_);
+
+  // Frames without the zone lower the average, until it leaves the window
+  const auto average = zone->average_;
+  profiler.end_frame();
+  REQUIRE(find_zone(name)->average_ <= average);
+  for (std::size_t i = 0; i < utils::Profiler::window_frames; i++) {
+    profiler.end_frame();
+  }
+  REQUIRE(find_zone(name)->maximum_ == std::chrono::nanoseconds{ 0 });
+}
+
+TEST_CASE("utils::Profiler: Chrome trace", "profiler")
+{
+  auto& profiler = utils::Profiler::get();
+  static const char* const outer = "test: outer";
+  static const char* const inner = "test: inner";
+  static const char* const worker = "test: worker";
+  {
+    const utils::Profiler::Zone zone{ outer };
+    run_zone(inner, std::chrono::microseconds{ 10 });
+  }
+  std::thread{ []() { run_zone(worker, std::chrono::microseconds{ 10 }); } }
+    .join();
+
+  const auto file = std::filesystem::temp_directory_path() / "b0mb3rman.trace";
+  profiler.write_chrome_trace(file);
+  const auto trace = utils::read_json(file);
+  const auto& events = trace.at("traceEvents");
+
+  auto find_event = [&](const char* name) {
+    return *std::find_if(events.begin(), events.end(), [name](const auto& e) {
+      return e.at("name") == name;
+    });
+  };
+  const auto outer_event = find_event(outer);
+  const auto inner_event = find_event(inner);
+  REQUIRE(outer_event.at("ph") == "X");
+  REQUIRE(outer_event.at("tid") == inner_event.at("tid"));
+  REQUIRE(inner_event.at("ts") >= outer_event.at("ts"));
+  REQUIRE(inner_event.at("dur") <= outer_event.at("dur"));
+  REQUIRE(find_event(worker).at("tid") != outer_event.at("tid"));
+}
+
+TEST_CASE("utils::Profiler: external durations", "profiler")
+{
+  auto& profiler = utils::Profiler::get();
+  static const char* const name = "test: gpu";
+  profiler.end_frame();
+  profiler.record_duration(name, std::chrono::milliseconds{ 2 });
+  profiler.record_duration(name, std::chrono::milliseconds{ 1 });
+  profiler.end_frame();
+
+  REQUIRE(find_zone(name)->maximum_ == std::chrono::milliseconds{ 3 });
+}
@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <fstream>
+
+#include <utils/resource_cache.hpp>
+
+namespace {
+struct Resource
+{
+  int value_{ 0 };
+};
+
+auto
+write_temporary_file(const std::string& name, const std::string& content)
+  -> std::filesystem::path
+{
+  const auto path = std::filesystem::temp_directory_path() / name;
+  std::ofstream{ path, std::ios::binary } << content;
+  return path;
+}
+} // namespace
+
+TEST_CASE("utils::ResourceKey: identifies path & content", "resource_cache")
+{
+  const auto path = write_temporary_file("b0mb3rman_key.txt", "content");
+  const auto key = utils::ResourceKey::from_file(path);
+  REQUIRE(key == utils::ResourceKey::from_file(path));
+  REQUIRE(key == utils::ResourceKey::from_file(
+                   path.parent_path() / "." / path.filename()));
+
+  // Of content, which has already been read
+  REQUIRE(key == utils::ResourceKey::from_content(path, "content"));
+
+  write_temporary_file("b0mb3rman_key.txt", "changed content");
+  REQUIRE_FALSE(key == utils::ResourceKey::from_file(path));
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("utils::ResourceCache: shares resident resources", "resource_cache")
+{
+  auto& cache = utils::ResourceCache<Resource>::get();
+  const auto key = utils::ResourceKey{ "resource", 1 };
+  REQUIRE(cache.find(key) == nullptr);
+
+  auto resource = cache.insert(key, std::make_shared<Resource>(Resource{ 1 }));
+  REQUIRE(cache.contains(key));
+  REQUIRE(cache.find(key) == resource);
+  REQUIRE(cache.find(utils::ResourceKey{ "resource", 2 }) == nullptr);
+
+  // Resource, inserted meanwhile, wins
+  auto other = cache.insert(key, std::make_shared<Resource>(Resource{ 2 }));
+  REQUIRE(other == resource);
+  REQUIRE(other->value_ == 1);
+}
+
+TEST_CASE("utils::ResourceCache: releases unowned resources", "resource_cache")
+{
+  auto& cache = utils::ResourceCache<Resource>::get();
+  const auto key = utils::ResourceKey{ "released", 1 };
+  {
+    auto resource = cache.insert(key, std::make_shared<Resource>());
+    REQUIRE(cache.contains(key));
+  }
+  REQUIRE_FALSE(cache.contains(key));
+  REQUIRE(cache.find(key) == nullptr);
+}
@@ -0,0 +1,34 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+#include <utils/string_interner.hpp>
+
+TEST_CASE("utils::StringInterner: indices", "string_interner")
+{
+  utils::StringInterner interner{ "default" };
+  REQUIRE(interner.get_size() == 1);
+  REQUIRE(interner.intern("default") == 0);
+
+  const auto fire = interner.intern("fire.json");
+  const auto bomb = interner.intern(std::string{ "bomb.json" });
+  REQUIRE(fire == 1);
+  REQUIRE(bomb == 2);
+  REQUIRE(interner.intern("fire.json") == fire);
+  REQUIRE(interner.get_size() == 3);
+
+  REQUIRE(interner.get_string(fire) == "fire.json");
+  REQUIRE(interner.get_string(bomb) == "bomb.json");
+  REQUIRE_THROWS(interner.get_string(3));
+}
+
+TEST_CASE("utils::StringInterner: strings stay in place", "string_interner")
+{
+  utils::StringInterner interner;
+  const auto& first = interner.get_string(interner.intern("first"));
+  for (int i = 0; i < 1000; i++) {
+    interner.intern("string " + std::to_string(i));
+  }
+  REQUIRE(first == "first");
+  REQUIRE(interner.intern("first") == 0);
+}
@@ -0,0 +1,41 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <stdexcept>
+
+#include <utils/thread_pool.hpp>
+
+TEST_CASE("utils::ThreadPool: results", "thread_pool")
+{
+  utils::ThreadPool pool{ 4 };
+  REQUIRE(pool.get_thread_count() == 4);
+
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 100; i++) {
+    results.emplace_back(pool.submit([i]() { return i * i; }));
+  }
+
+  for (int i = 0; i < 100; i++) {
+    REQUIRE(results.at(i).get() == i * i);
+  }
+}
+
+TEST_CASE("utils::ThreadPool: exception", "thread_pool")
+{
+  utils::ThreadPool pool{ 2 };
+  auto result = pool.submit([]() -> int { throw std::runtime_error("fail"); });
+  REQUIRE_THROWS_AS(result.get(), std::runtime_error);
+}
+
+TEST_CASE("utils::ThreadPool: queued tasks finish on destruction",
+          "thread_pool")
+{
+  std::atomic<int> counter{ 0 };
+  {
+    utils::ThreadPool pool{ 1 };
+    for (int i = 0; i < 50; i++) {
+      pool.submit([&counter]() { counter++; });
+    }
+  }
+  REQUIRE(counter == 50);
+}